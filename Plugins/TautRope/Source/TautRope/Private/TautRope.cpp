@@ -1,8 +1,96 @@
 #include "TautRope.h"
 #include "TautRopeHelpersCollision.h"
+#include "TautRopeHelpersCurved.h"
 #include "TautRopeHelpersMovement.h"
 #include "TautRopeHelpersPruning.h"
 #include "TautRopeHelpersVertexHandling.h"
+#include "TautRopeModule.h"
+#include "TautRopeRecording.h"
+
+#include "Algo/BinarySearch.h"
+#include "Async/Async.h"
+#include "Misc/DateTime.h"
+
+static TAutoConsoleVariable<float> CVarCaptureTimeBudgetMs(
+	TEXT("TautRope.Capture.TimeBudgetMs"),
+	0.f,
+	TEXT("Dump a repro to Saved/TautRope when a single rope update takes longer than this many milliseconds.\n")
+	TEXT("0: Off"),
+	ECVF_Default
+);
+
+static TAutoConsoleVariable<int32> CVarCaptureOnMaxCollisionIterations(
+	TEXT("TautRope.Capture.OnMaxCollisionIterations"),
+	0,
+	TEXT("Dump a repro to Saved/TautRope when the collision phase hits TAUT_ROPE_MAX_COLLISION_ITERATIONS.\n")
+	TEXT("0: Off\n")
+	TEXT("1: On"),
+	ECVF_Default
+);
+
+static TAutoConsoleVariable<int32> CVarMaxSubsteps(
+	TEXT("TautRope.Substep.MaxSubsteps"),
+	4,
+	TEXT("Maximum number of substeps a rope update is split into when its endpoints move far relative to nearby shape edges.\n")
+	TEXT("1: Off"),
+	ECVF_Default
+);
+
+static TAutoConsoleVariable<float> CVarSubstepEdgeLengthScale(
+	TEXT("TautRope.Substep.EdgeLengthScale"),
+	1.f,
+	TEXT("Endpoint displacement allowed per substep, relative to the mean edge length of the finest shape the motion passes."),
+	ECVF_Default
+);
+
+static TAutoConsoleVariable<int32> CVarCollisionIterationsPerUpdate(
+	TEXT("TautRope.Collision.IterationsPerUpdate"),
+	0,
+	TEXT("Collision iterations a single rope update may run before the solve continues in the next update.\n")
+	TEXT("0: Unlimited"),
+	ECVF_Default
+);
+
+static TAutoConsoleVariable<float> CVarCollisionTimeBudgetMs(
+	TEXT("TautRope.Collision.TimeBudgetMs"),
+	0.f,
+	TEXT("Time a single rope update may spend before the collision solve continues in the next update.\n")
+	TEXT("0: Unlimited"),
+	ECVF_Default
+);
+
+static TAutoConsoleVariable<int32> CVarCollisionMaxHitsPerSweep(
+	TEXT("TautRope.Collision.MaxHitsPerSweep"),
+	8,
+	TEXT("Contacts a single segment sweep may add in one collision iteration, following the rope from its first hit.\n")
+	TEXT("1: Only the first hit"),
+	ECVF_Default
+);
+
+static TAutoConsoleVariable<int32> CVarCollisionLocalSearchHops(
+	TEXT("TautRope.Collision.LocalSearchHops"),
+	2,
+	TEXT("Steps along shared vertices from the contact edges of a segment whose points touch the same shape. Sweeps that stay\n")
+	TEXT("around those edges only test them on that shape.\n")
+	TEXT("0: Always test every edge"),
+	ECVF_Default
+);
+
+static TAutoConsoleVariable<int32> CVarMovementTighteningMode(
+	TEXT("TautRope.Movement.TighteningMode"),
+	1,
+	TEXT("How far interior rope points are tightened each update.\n")
+	TEXT("0: Each point moves once toward its neighbours\n")
+	TEXT("1: Runs of contacts on one shape are tightened to their shortest path in one solve"),
+	ECVF_Default
+);
+
+static TAutoConsoleVariable<int32> CVarCaptureMaxCount(
+	TEXT("TautRope.Capture.MaxCount"),
+	16,
+	TEXT("Maximum number of repros dumped per session."),
+	ECVF_Default
+);
 
 #if TAUT_ROPE_DEBUG_DRAWING
 static TAutoConsoleVariable<int32> CVarDrawDebugRope(
@@ -44,18 +132,355 @@ static TAutoConsoleVariable<int32> CVarDrawDebugRemoveSweep(
 
 void FTautRope::AppendToNearbyShapes(const TConstArrayView<FTautRopeCollisionShape>& Shapes)
 {
+	// Foreign rope segments are kept at the end of the shapes.
+	ensure(ForeignSegments.IsEmpty());
+	const int32 FirstNewShapeIndex = NearbyShapes.Num();
 	NearbyShapes.Append(Shapes);
+	for (int32 ShapeIndex = FirstNewShapeIndex; ShapeIndex < NearbyShapes.Num(); ++ShapeIndex)
+	{
+		// Runtime poses are not saved with the shape.
+		FTautRopeCollisionShape& Shape = NearbyShapes[ShapeIndex];
+		Shape.PrevTransform = Shape.Transform;
+		Shape.TargetTransform = Shape.Transform;
+#if TAUT_ROPE_FLOAT_SWEEP_KERNEL
+		Shape.BuildKernelEdges();
+#endif
+		Shape.BuildEdgeBounds();
+		Shape.BuildEdgeGrid();
+		NearbyShapeBounds.Add(Shape.CalcBounds());
+		const FTautRopeCollisionShape& Geometry = Shape.GetGeometry();
+		float EdgeLengthSum = 0.f;
+		for (const FIntVector2& Edge : Geometry.Edges)
+		{
+			EdgeLengthSum += FVector::Dist(Shape.GetLocalVertex(Edge.X), Shape.GetLocalVertex(Edge.Y));
+		}
+		NearbyShapeMeanEdgeLengths.Add(Geometry.Edges.IsEmpty() ? 0.f : EdgeLengthSum / Geometry.Edges.Num());
+	}
 }
 
 TArray<FVector> FTautRope::GetRopePoints() const
 {
+	if (CollisionSolve.bIsActive)
+	{
+		return ConsistentRopeLocations;
+	}
 	TArray<FVector> Result;
-	Result.SetNum(RopePoints.Num());
+	TArray<FIntVector> Features;
+	BuildPath(Result, Features);
+	return Result;
+}
+
+void FTautRope::BuildPath(TArray<FVector>& OutLocations, TArray<FIntVector>& OutFeatures) const
+{
+	OutLocations.Reset(RopePoints.Num());
+	OutFeatures.Reset(RopePoints.Num());
 	for (int32 i = 0; i < RopePoints.Num(); ++i)
 	{
-		Result[i] = RopePoints[i].Location;
+		const TautRope::FPoint& Point = RopePoints[i];
+		OutLocations.Add(Point.Location);
+		OutFeatures.Add(FIntVector(Point.ShapeIndex, Point.EdgeIndex, Point.VertIndex));
+		if (TautRope::IsCurvedWrapSegment(RopePoints, i, NearbyShapes))
+		{
+			const FVector& Before = i > 0 ? RopePoints[i - 1].Location : Point.Location;
+			TautRope::AppendCurvedWrapLocations(NearbyShapes[Point.ShapeIndex], Before, Point.Location, RopePoints[i + 1].Location, OutLocations);
+			while (OutFeatures.Num() < OutLocations.Num())
+			{
+				OutFeatures.Add(FIntVector(Point.ShapeIndex, INDEX_NONE, INDEX_NONE));
+			}
+		}
 	}
-	return Result;
+}
+
+FVector FTautRope::GetLocationAtDistance(const float Distance) const
+{
+	if (PathLocations.Num() < 2)
+	{
+		return PathLocations.IsEmpty() ? FVector::ZeroVector : PathLocations[0];
+	}
+	const int32 SegmentIndex = FindArcSegment(Distance);
+	const float SegmentLength = CumulativeArcLengths[SegmentIndex + 1] - CumulativeArcLengths[SegmentIndex];
+	const float Alpha = SegmentLength > KINDA_SMALL_NUMBER
+		? FMath::Clamp((Distance - CumulativeArcLengths[SegmentIndex]) / SegmentLength, 0.f, 1.f)
+		: 0.f;
+	return FMath::Lerp(PathLocations[SegmentIndex], PathLocations[SegmentIndex + 1], Alpha);
+}
+
+FVector FTautRope::GetTangentAtDistance(const float Distance) const
+{
+	if (PathLocations.Num() < 2)
+	{
+		return FVector::ZeroVector;
+	}
+	const int32 SegmentIndex = FindArcSegment(Distance);
+	return (PathLocations[SegmentIndex + 1] - PathLocations[SegmentIndex]).GetSafeNormal();
+}
+
+float FTautRope::GetDistanceClosestToLocation(const FVector& Location) const
+{
+	float ClosestDistance = 0.f;
+	float MinDistanceSquared = MAX_FLT;
+	for (int32 i = 0; i < PathLocations.Num() - 1; ++i)
+	{
+		const FVector Closest = FMath::ClosestPointOnSegment(Location, PathLocations[i], PathLocations[i + 1]);
+		const float DistanceSquared = FVector::DistSquared(Location, Closest);
+		if (DistanceSquared < MinDistanceSquared)
+		{
+			MinDistanceSquared = DistanceSquared;
+			ClosestDistance = CumulativeArcLengths[i] + FVector::Dist(PathLocations[i], Closest);
+		}
+	}
+	return ClosestDistance;
+}
+
+int32 FTautRope::FindArcSegment(const float Distance) const
+{
+	const int32 UpperIndex = Algo::UpperBound(CumulativeArcLengths, Distance);
+	return FMath::Clamp(UpperIndex - 1, 0, CumulativeArcLengths.Num() - 2);
+}
+
+bool FTautRope::RefreshPath(const float MaxLength)
+{
+	ArcMaxLength = MaxLength;
+	TArray<FVector> Locations;
+	TArray<FIntVector> Features;
+	if (CollisionSolve.bIsActive)
+	{
+		Locations = ConsistentRopeLocations;
+		Features = ConsistentRopeFeatures;
+	}
+	else
+	{
+		BuildPath(Locations, Features);
+	}
+	const int32 NumLocations = Locations.Num();
+	const int32 NumPrevLocations = PathLocations.Num();
+
+	// Segments in the unchanged head and tail of the path keep their lengths, only the ones in between are measured again.
+	const int32 MaxNumSame = FMath::Min(NumLocations, NumPrevLocations);
+	int32 NumSameHead = 0;
+	while (NumSameHead < MaxNumSame && Locations[NumSameHead] == PathLocations[NumSameHead])
+	{
+		++NumSameHead;
+	}
+	int32 NumSameTail = 0;
+	while (NumSameTail < MaxNumSame - NumSameHead && Locations[NumLocations - 1 - NumSameTail] == PathLocations[NumPrevLocations - 1 - NumSameTail])
+	{
+		++NumSameTail;
+	}
+	if (NumSameHead == NumLocations && NumLocations == NumPrevLocations && Features == PathFeatures)
+	{
+		return false;
+	}
+
+	TArray<float> PrevCumulativeArcLengths = MoveTemp(CumulativeArcLengths);
+	CumulativeArcLengths.SetNumUninitialized(NumLocations);
+	for (int32 i = 0; i < NumLocations; ++i)
+	{
+		if (i < NumSameHead)
+		{
+			CumulativeArcLengths[i] = PrevCumulativeArcLengths[i];
+			continue;
+		}
+		float SegmentLength = 0.f;
+		if (i > NumLocations - NumSameTail)
+		{
+			const int32 PrevIndex = i + NumPrevLocations - NumLocations;
+			SegmentLength = PrevCumulativeArcLengths[PrevIndex] - PrevCumulativeArcLengths[PrevIndex - 1];
+		}
+		else if (i > 0)
+		{
+			SegmentLength = FVector::Dist(Locations[i - 1], Locations[i]);
+		}
+		CumulativeArcLengths[i] = (i > 0 ? CumulativeArcLengths[i - 1] : 0.f) + SegmentLength;
+	}
+	PathLocations = MoveTemp(Locations);
+	PathFeatures = MoveTemp(Features);
+	++PathVersion;
+	return true;
+}
+
+void FTautRope::BroadcastContactChanges()
+{
+	// Mid solve the rope points are not a consistent path yet.
+	if (CollisionSolve.bIsActive)
+	{
+		return;
+	}
+	TArray<FContact> NewContacts;
+	NewContacts.Reserve(RopePoints.Num());
+	for (int32 i = 1; i < RopePoints.Num() - 1; ++i)
+	{
+		const TautRope::FPoint& Point = RopePoints[i];
+		// Both points of a curved wrap are one contact.
+		if (Point.ShapeIndex == INDEX_NONE || (Point.EdgeIndex == INDEX_NONE && RopePoints[i - 1].ShapeIndex == Point.ShapeIndex))
+		{
+			continue;
+		}
+		NewContacts.Add({ Point.ShapeIndex, Point.EdgeIndex, Point.Location });
+	}
+	NewContacts.Sort();
+
+	// Both lists are sorted, so one merge pass finds what was added and removed.
+	int32 PrevIndex = 0;
+	int32 NewIndex = 0;
+	while (PrevIndex < Contacts.Num() || NewIndex < NewContacts.Num())
+	{
+		if (NewIndex == NewContacts.Num() || (PrevIndex < Contacts.Num() && Contacts[PrevIndex] < NewContacts[NewIndex]))
+		{
+			OnContactRemoved.Broadcast(Contacts[PrevIndex].ShapeIndex, Contacts[PrevIndex].Location);
+			++PrevIndex;
+		}
+		else if (PrevIndex == Contacts.Num() || NewContacts[NewIndex] < Contacts[PrevIndex])
+		{
+			OnContactAdded.Broadcast(NewContacts[NewIndex].ShapeIndex, NewContacts[NewIndex].Location);
+			++NewIndex;
+		}
+		else
+		{
+			++PrevIndex;
+			++NewIndex;
+		}
+	}
+	Contacts = MoveTemp(NewContacts);
+}
+
+void FTautRope::SetShapeTargetTransform(const int32 ShapeIndex, const FTransform& TargetTransform)
+{
+	if (ensure(NearbyShapes.IsValidIndex(ShapeIndex) && NearbyShapes[ShapeIndex].bIsLocalSpace))
+	{
+		NearbyShapes[ShapeIndex].TargetTransform = TargetTransform;
+	}
+}
+
+void FTautRope::SetForeignRopeSegments(const TConstArrayView<TautRope::FRopeSegment> Segments)
+{
+	if (CollisionSolve.bIsActive)
+	{
+		return;
+	}
+	const int32 FirstForeignShapeIndex = NearbyShapes.Num() - ForeignSegments.Num();
+	const TArray<TautRope::FRopeSegment> PrevSegments = MoveTemp(ForeignSegments);
+	const TArray<FTautRopeCollisionShape> PrevShapes(NearbyShapes.GetData() + FirstForeignShapeIndex, PrevSegments.Num());
+	NearbyShapes.SetNum(FirstForeignShapeIndex);
+	NearbyShapeBounds.SetNum(FirstForeignShapeIndex);
+	NearbyShapeMeanEdgeLengths.SetNum(FirstForeignShapeIndex);
+
+	auto GetSegmentId = [](const TautRope::FRopeSegment& Segment)
+		{
+			return (static_cast<uint64>(Segment.RopeId) << 32) | Segment.Key;
+		};
+	TMap<uint64, int32> PrevIndexBySegmentId;
+	PrevIndexBySegmentId.Reserve(PrevSegments.Num());
+	for (int32 PrevIndex = 0; PrevIndex < PrevSegments.Num(); ++PrevIndex)
+	{
+		PrevIndexBySegmentId.Add(GetSegmentId(PrevSegments[PrevIndex]), PrevIndex);
+	}
+	TArray<int32> PrevToShapeIndex;
+	PrevToShapeIndex.Init(INDEX_NONE, PrevSegments.Num());
+	for (const TautRope::FRopeSegment& Segment : Segments)
+	{
+		const FVector Axis = Segment.End - Segment.Start;
+		FTautRopeCollisionShape& Shape = NearbyShapes.AddDefaulted_GetRef();
+		Shape.Type = ETautRopeCollisionShapeType::Capsule;
+		Shape.bIsLocalSpace = true;
+		Shape.bIsTransient = true;
+		Shape.Radius = Segment.Radius;
+		Shape.HalfLength = Axis.Size() * 0.5f;
+		Shape.TargetTransform = FTransform(
+			FQuat::FindBetweenNormals(FVector::UpVector, Axis.GetSafeNormal(UE_SMALL_NUMBER, FVector::UpVector))
+			, (Segment.Start + Segment.End) * 0.5
+		);
+		// A segment that was there before moves from its last pose, so the update sweeps its motion.
+		const int32* PrevIndex = PrevIndexBySegmentId.Find(GetSegmentId(Segment));
+		Shape.Transform = PrevIndex != nullptr ? PrevShapes[*PrevIndex].Transform : Shape.TargetTransform;
+		Shape.PrevTransform = Shape.Transform;
+		if (PrevIndex != nullptr)
+		{
+			PrevToShapeIndex[*PrevIndex] = NearbyShapes.Num() - 1;
+		}
+		NearbyShapeBounds.Add(Shape.CalcBounds());
+		NearbyShapeMeanEdgeLengths.Add(0.f);
+	}
+	ForeignSegments = Segments;
+
+	for (int32 i = RopePoints.Num() - 2; i > 0; --i)
+	{
+		TautRope::FPoint& Point = RopePoints[i];
+		if (Point.ShapeIndex < FirstForeignShapeIndex)
+		{
+			continue;
+		}
+		const int32 PrevIndex = Point.ShapeIndex - FirstForeignShapeIndex;
+		Point.ShapeIndex = PrevToShapeIndex[PrevIndex];
+		if (Point.ShapeIndex != INDEX_NONE)
+		{
+			continue;
+		}
+		// The segment was split or merged by a change of its rope, so the contact carries over to what took its place.
+		float MinDistance = PrevSegments[PrevIndex].Radius * 2.f;
+		for (int32 SegmentIndex = 0; SegmentIndex < ForeignSegments.Num(); ++SegmentIndex)
+		{
+			const TautRope::FRopeSegment& Segment = ForeignSegments[SegmentIndex];
+			const float Distance = FMath::PointDistToSegment(Point.Location, Segment.Start, Segment.End);
+			if (Segment.RopeId == PrevSegments[PrevIndex].RopeId && Distance < MinDistance)
+			{
+				MinDistance = Distance;
+				Point.ShapeIndex = FirstForeignShapeIndex + SegmentIndex;
+			}
+		}
+		if (Point.ShapeIndex == INDEX_NONE)
+		{
+			RopePoints.RemoveAt(i);
+			continue;
+		}
+		const TautRope::FRopeSegment& Segment = ForeignSegments[Point.ShapeIndex - FirstForeignShapeIndex];
+		const FVector OnAxis = FMath::ClosestPointOnSegment(Point.Location, Segment.Start, Segment.End);
+		Point.Location = OnAxis + (Point.Location - OnAxis).GetSafeNormal() * Segment.Radius;
+	}
+	// Keeps contact events about what changed on the ropes, not about the shapes being rebuilt.
+	for (FContact& Contact : Contacts)
+	{
+		if (Contact.ShapeIndex >= FirstForeignShapeIndex && PrevToShapeIndex.IsValidIndex(Contact.ShapeIndex - FirstForeignShapeIndex))
+		{
+			const int32 ShapeIndex = PrevToShapeIndex[Contact.ShapeIndex - FirstForeignShapeIndex];
+			Contact.ShapeIndex = ShapeIndex != INDEX_NONE ? ShapeIndex : MAX_int32;
+		}
+	}
+	Contacts.Sort();
+}
+
+void FTautRope::ResetRopePoints(
+	const TArray<TautRope::FPoint>& InRopePoints
+	, const float MaxLength
+)
+{
+	RopePoints = InRopePoints;
+	CollisionSolve = TautRope::FCollisionSolveState();
+	if (RefreshPath(MaxLength))
+	{
+		BroadcastContactChanges();
+	}
+}
+
+void FTautRope::StartRecording()
+{
+	ActiveRecording = MakeShared<TautRope::FRecording>();
+	const int32 NumOwnShapes = NearbyShapes.Num() - ForeignSegments.Num();
+	ActiveRecording->Shapes.Append(NearbyShapes.GetData(), NumOwnShapes);
+	ActiveRecording->InitialForeignSegments = ForeignSegments;
+	ActiveRecording->InitialRopePoints = RopePoints;
+	RecordedShapeTransforms.Reset(NumOwnShapes);
+	for (int32 ShapeIndex = 0; ShapeIndex < NumOwnShapes; ++ShapeIndex)
+	{
+		RecordedShapeTransforms.Add(NearbyShapes[ShapeIndex].Transform);
+	}
+}
+
+TSharedPtr<TautRope::FRecording> FTautRope::StopRecording()
+{
+	TSharedPtr<TautRope::FRecording> Recording = MoveTemp(ActiveRecording);
+	ActiveRecording.Reset();
+	return Recording;
 }
 
 void FTautRope::UpdateRope(
@@ -67,28 +492,310 @@ void FTautRope::UpdateRope(
 #endif // TAUT_ROPE_DEBUG_DRAWING
 )
 {
+	const double UpdateStartSeconds = FPlatformTime::Seconds();
+	const float CaptureTimeBudgetMs = CVarCaptureTimeBudgetMs.GetValueOnGameThread();
+	const bool bCaptureOnMaxCollisionIterations = CVarCaptureOnMaxCollisionIterations.GetValueOnGameThread() != 0;
+	TArray<TautRope::FPoint> InputRopePoints;
+	TArray<FTransform> InputShapeTransforms;
+	if (CaptureTimeBudgetMs > 0.f || bCaptureOnMaxCollisionIterations)
+	{
+		InputRopePoints = RopePoints;
+		for (const FTautRopeCollisionShape& Shape : NearbyShapes)
+		{
+			if (Shape.bIsLocalSpace)
+			{
+				InputShapeTransforms.Add(Shape.Transform);
+			}
+		}
+	}
+
+	for (FTautRopeCollisionShape& Shape : NearbyShapes)
+	{
+		if (Shape.bIsLocalSpace)
+		{
+			Shape.RefreshTargetTransform();
+		}
+	}
+
+	const int32 IterationsPerUpdate = CVarCollisionIterationsPerUpdate.GetValueOnGameThread();
+	const float CollisionTimeBudgetMs = CVarCollisionTimeBudgetMs.GetValueOnGameThread();
+	int32 CollisionIterationBudget = IterationsPerUpdate > 0 ? IterationsPerUpdate : MAX_int32;
+	const double CollisionDeadlineSeconds = CollisionTimeBudgetMs > 0.f
+		? UpdateStartSeconds + CollisionTimeBudgetMs * 0.001
+		: MAX_dbl;
+
+	int32 CollisionIterations = 0;
 	if (RopePoints.Num() < 2)
 	{
 		RopePoints.Empty();
 		RopePoints.Add(TautRope::FPoint(StartLocation));
 		RopePoints.Add(TautRope::FPoint(EndLocation));
-		return;
 	}
+	else if (CollisionSolve.bIsActive)
+	{
+		// The new targets are picked up once the solve left over from an earlier update is done.
+		ResumeStep(
+			CollisionIterationBudget
+			, CollisionDeadlineSeconds
+#if TAUT_ROPE_DEBUG_DRAWING
+			, World
+#endif // TAUT_ROPE_DEBUG_DRAWING
+		);
+		CollisionIterations = CollisionSolve.Iterations;
+	}
+	else
+	{
+		// Large endpoint motions are split so each collision sweep stays local.
+		const int32 NumSubsteps = GetNumSubsteps(StartLocation, EndLocation);
+		const FVector PrevStartLocation = RopePoints[0].Location;
+		const FVector PrevEndLocation = RopePoints.Last().Location;
+		// Moving shapes are blended along with the endpoints, so each step sweeps the relative motion since the step before.
+		TArray<TPair<int32, FTransform>> MovingShapeStartTransforms;
+		for (int32 ShapeIndex = 0; ShapeIndex < NearbyShapes.Num(); ++ShapeIndex)
+		{
+			FTautRopeCollisionShape& Shape = NearbyShapes[ShapeIndex];
+			Shape.PrevTransform = Shape.Transform;
+			if (Shape.bIsLocalSpace && !Shape.TargetTransform.Equals(Shape.Transform))
+			{
+				MovingShapeStartTransforms.Emplace(ShapeIndex, Shape.Transform);
+			}
+		}
+		for (int32 Substep = 1; Substep <= NumSubsteps; ++Substep)
+		{
+			const float SubstepAlpha = static_cast<float>(Substep) / NumSubsteps;
+			for (const TPair<int32, FTransform>& MovingShape : MovingShapeStartTransforms)
+			{
+				FTautRopeCollisionShape& Shape = NearbyShapes[MovingShape.Key];
+				Shape.PrevTransform = Shape.Transform;
+				Shape.Transform.Blend(MovingShape.Value, Shape.TargetTransform, SubstepAlpha);
+				NearbyShapeBounds[MovingShape.Key] = Shape.CalcBounds();
+			}
+			const bool bIsStepComplete = StepRope(
+				FMath::Lerp(PrevStartLocation, StartLocation, SubstepAlpha)
+				, FMath::Lerp(PrevEndLocation, EndLocation, SubstepAlpha)
+				, MaxLength
+				, CollisionIterationBudget
+				, CollisionDeadlineSeconds
+#if TAUT_ROPE_DEBUG_DRAWING
+				, World
+#endif // TAUT_ROPE_DEBUG_DRAWING
+			);
+			CollisionIterations = FMath::Max(CollisionIterations, CollisionSolve.Iterations);
+			if (!bIsStepComplete)
+			{
+				break;
+			}
+		}
+	}
+
+	if (RefreshPath(MaxLength))
+	{
+		BroadcastContactChanges();
+	}
+
+	const float UpdateMs = (FPlatformTime::Seconds() - UpdateStartSeconds) * 1000.0;
+	if (ActiveRecording.IsValid())
+	{
+		TautRope::FRecordingFrame& Frame = ActiveRecording->Frames.AddDefaulted_GetRef();
+		Frame.StartLocation = StartLocation;
+		Frame.EndLocation = EndLocation;
+		Frame.MaxLength = MaxLength;
+		Frame.RecordedMs = UpdateMs;
+		// Most local space shapes are placed instances that never move, so only changed targets are written. Foreign rope
+		// segments are rebuilt every update and go in whole.
+		const int32 NumRecordedShapes = FMath::Min(RecordedShapeTransforms.Num(), NearbyShapes.Num());
+		for (int32 ShapeIndex = 0; ShapeIndex < NumRecordedShapes; ++ShapeIndex)
+		{
+			const FTautRopeCollisionShape& Shape = NearbyShapes[ShapeIndex];
+			if (Shape.bIsLocalSpace && !Shape.bIsTransient && !Shape.TargetTransform.Equals(RecordedShapeTransforms[ShapeIndex]))
+			{
+				RecordedShapeTransforms[ShapeIndex] = Shape.TargetTransform;
+				Frame.ShapeTransformIndices.Add(ShapeIndex);
+				Frame.ShapeTransforms.Add(Shape.TargetTransform);
+			}
+		}
+		Frame.ForeignSegments = ForeignSegments;
+	}
+
+	if (bCaptureOnMaxCollisionIterations && CollisionIterations >= TAUT_ROPE_MAX_COLLISION_ITERATIONS)
+	{
+		CaptureRepro(InputRopePoints, InputShapeTransforms, StartLocation, EndLocation, MaxLength, UpdateMs, TEXT("MaxIterations"));
+	}
+	else if (CaptureTimeBudgetMs > 0.f && UpdateMs > CaptureTimeBudgetMs)
+	{
+		CaptureRepro(InputRopePoints, InputShapeTransforms, StartLocation, EndLocation, MaxLength, UpdateMs, TEXT("OverBudget"));
+	}
+}
+
+bool FTautRope::StepRope(
+	const FVector& StartLocation
+	, const FVector& EndLocation
+	, const float MaxLength
+	, int32& InOutCollisionIterationBudget
+	, const double CollisionDeadlineSeconds
+#if TAUT_ROPE_DEBUG_DRAWING
+	, const UWorld* World
+#endif // TAUT_ROPE_DEBUG_DRAWING
+)
+{
+	BuildPath(ConsistentRopeLocations, ConsistentRopeFeatures);
+
 	// Move phase
-	TArray<FVector> TargetRopePoints = MovementPhase(StartLocation, EndLocation, MaxLength);
+	CollisionSolve.TargetRopePoints = MovementPhase(StartLocation, EndLocation, MaxLength);
+	CollisionSolve.OriginRopePoints.SetNum(RopePoints.Num());
+	for (int32 i = 0; i < RopePoints.Num(); ++i)
+	{
+		CollisionSolve.OriginRopePoints[i] = RopePoints[i].Location;
+	}
+	CollisionSolve.PendingSegments.Init(true, RopePoints.Num() - 1);
+	CollisionSolve.Iterations = 0;
+	CollisionSolve.bIsActive = true;
+
+	return ResumeStep(
+		InOutCollisionIterationBudget
+		, CollisionDeadlineSeconds
+#if TAUT_ROPE_DEBUG_DRAWING
+		, World
+#endif // TAUT_ROPE_DEBUG_DRAWING
+	);
+}
+
+bool FTautRope::ResumeStep(
+	int32& InOutCollisionIterationBudget
+	, const double CollisionDeadlineSeconds
+#if TAUT_ROPE_DEBUG_DRAWING
+	, const UWorld* World
+#endif // TAUT_ROPE_DEBUG_DRAWING
+)
+{
 	// Collision phase
-	const bool bHadCollision = CollisionPhase(
-		TargetRopePoints
+	const bool bIsCollisionSolved = CollisionPhase(
+		InOutCollisionIterationBudget
+		, CollisionDeadlineSeconds
 #if TAUT_ROPE_DEBUG_DRAWING
 		, World
 #endif // TAUT_ROPE_DEBUG_DRAWING
 	);
+	if (!bIsCollisionSolved)
+	{
+		return false;
+	}
+	CollisionSolve.bIsActive = false;
+
 	// Pruning phase
 	const bool bWasPruned = PruningPhase(
 #if TAUT_ROPE_DEBUG_DRAWING
 		World
 #endif // TAUT_ROPE_DEBUG_DRAWING
 	);
+	return true;
+}
+
+int32 FTautRope::GetNumSubsteps(
+	const FVector& StartLocation
+	, const FVector& EndLocation
+) const
+{
+	const int32 MaxSubsteps = CVarMaxSubsteps.GetValueOnGameThread();
+	if (MaxSubsteps <= 1)
+	{
+		return 1;
+	}
+	const float Displacement = FMath::Max(
+		FVector::Dist(RopePoints[0].Location, StartLocation)
+		, FVector::Dist(RopePoints.Last().Location, EndLocation)
+	);
+	if (Displacement < TAUT_ROPE_DISTANCE_TOLERANCE)
+	{
+		return 1;
+	}
+
+	FBox MotionBounds(ForceInit);
+	for (const TautRope::FPoint& Point : RopePoints)
+	{
+		MotionBounds += Point.Location;
+	}
+	MotionBounds += StartLocation;
+	MotionBounds += EndLocation;
+
+	// The finest shape the motion passes sets how far an endpoint may move per substep.
+	float MinMeanEdgeLength = MAX_FLT;
+	for (int32 ShapeIndex = 0; ShapeIndex < NearbyShapes.Num(); ++ShapeIndex)
+	{
+		if (NearbyShapeMeanEdgeLengths[ShapeIndex] > 0.f && NearbyShapeBounds[ShapeIndex].Intersect(MotionBounds))
+		{
+			MinMeanEdgeLength = FMath::Min(MinMeanEdgeLength, NearbyShapeMeanEdgeLengths[ShapeIndex]);
+		}
+	}
+	if (MinMeanEdgeLength == MAX_FLT)
+	{
+		return 1;
+	}
+	const float SubstepDisplacement = FMath::Max(MinMeanEdgeLength * CVarSubstepEdgeLengthScale.GetValueOnGameThread(), TAUT_ROPE_DISTANCE_TOLERANCE);
+	return FMath::Clamp(FMath::CeilToInt32(Displacement / SubstepDisplacement), 1, MaxSubsteps);
+}
+
+void FTautRope::CaptureRepro(
+	const TArray<TautRope::FPoint>& InputRopePoints
+	, const TArray<FTransform>& InputShapeTransforms
+	, const FVector& StartLocation
+	, const FVector& EndLocation
+	, const float MaxLength
+	, const float UpdateMs
+	, const TCHAR* Reason
+) const
+{
+	static int32 NumCapturedRepros = 0;
+	if (NumCapturedRepros >= CVarCaptureMaxCount.GetValueOnGameThread())
+	{
+		return;
+	}
+	++NumCapturedRepros;
+
+	TautRope::FRecordingFrame Frame;
+	Frame.StartLocation = StartLocation;
+	Frame.EndLocation = EndLocation;
+	Frame.MaxLength = MaxLength;
+	Frame.RecordedMs = UpdateMs;
+	// Local space shapes start from where they were before the update and move to where they were asked to go.
+	TArray<FTautRopeCollisionShape> InputShapes = NearbyShapes;
+	int32 LocalShapeIndex = 0;
+	for (int32 ShapeIndex = 0; ShapeIndex < InputShapes.Num(); ++ShapeIndex)
+	{
+		FTautRopeCollisionShape& Shape = InputShapes[ShapeIndex];
+		if (Shape.bIsLocalSpace && InputShapeTransforms.IsValidIndex(LocalShapeIndex))
+		{
+			Shape.Transform = InputShapeTransforms[LocalShapeIndex++];
+			if (!Shape.TargetTransform.Equals(Shape.Transform))
+			{
+				Frame.ShapeTransformIndices.Add(ShapeIndex);
+				Frame.ShapeTransforms.Add(Shape.TargetTransform);
+			}
+		}
+	}
+	TautRope::FRecording Repro = TautRope::MakeFrameRepro(InputShapes, InputRopePoints, Frame);
+
+	const FString FilePath = TautRope::GetReprosDir() / FString::Printf(
+		TEXT("%s_%s_%d.trrec")
+		, Reason
+		, *FDateTime::Now().ToString()
+		, NumCapturedRepros
+	);
+	UE_LOG(LogTautRope, Warning, TEXT("Rope update took %.3f ms (%s), capturing repro with %d points and %d shapes to %s")
+		, UpdateMs
+		, Reason
+		, InputRopePoints.Num()
+		, Repro.Shapes.Num()
+		, *FilePath
+	);
+	// Keep the file write out of the frame that already spiked.
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [Repro = MoveTemp(Repro), FilePath]()
+		{
+			if (!Repro.SaveToFile(FilePath))
+			{
+				UE_LOG(LogTautRope, Warning, TEXT("Failed to save rope repro %s"), *FilePath);
+			}
+		});
 }
 
 TArray<FVector> FTautRope::MovementPhase(
@@ -99,6 +806,17 @@ TArray<FVector> FTautRope::MovementPhase(
 {
 	ensure(RopePoints.Num() >= 2);
 
+	// A curved contact from the collision phase becomes an entry and exit pair that the wrap opens up between.
+	for (int32 i = RopePoints.Num() - 2; i > 0; --i)
+	{
+		const int32 ShapeIndex = RopePoints[i].ShapeIndex;
+		if (NearbyShapes[ShapeIndex].IsCurved() && RopePoints[i - 1].ShapeIndex != ShapeIndex && RopePoints[i + 1].ShapeIndex != ShapeIndex)
+		{
+			const TautRope::FPoint ExitPoint = RopePoints[i];
+			RopePoints.Insert(ExitPoint, i + 1);
+		}
+	}
+
 	TArray<FVector> RopeTargetLocations;
 
 	RopeTargetLocations.SetNum(RopePoints.Num());
@@ -107,10 +825,7 @@ TArray<FVector> FTautRope::MovementPhase(
 	float RopeDistanceToSecondLastPoint = 0.f;
 	for (int32 Index = 0; Index < RopePoints.Num() - 2; ++Index)
 	{
-		RopeDistanceToSecondLastPoint += FVector::Dist(
-			RopePoints[Index].Location
-			, RopePoints[Index + 1].Location
-		);
+		RopeDistanceToSecondLastPoint += TautRope::GetRopeSegmentLength(RopePoints, Index, NearbyShapes);
 	}
 	const float AvaliableDistanceTowardsEndPoint = MaxLength - RopeDistanceToSecondLastPoint;
 	const FVector SecondLastPointLocation = RopePoints[RopePoints.Num() - 2].Location;
@@ -124,43 +839,82 @@ TArray<FVector> FTautRope::MovementPhase(
 	}
 	for (int32 i = 1; i < RopePoints.Num() - 1; ++i)
 	{
-		RopeTargetLocations[i] = RopePoints[i].Location;
+		RopeTargetLocations[i] = NearbyShapes[RopePoints[i].ShapeIndex].MoveWithShape(RopePoints[i].Location);
 	}
-	// TODO: Grouping of rope points that belong to the same vertex fan of edges so we can draw a straight line across multiple edges in 2d space,
+	if (CVarMovementTighteningMode.GetValueOnGameThread() == 1)
+	{
+		// The per point pass below then only has to settle vertex crossings at the ends of the tightened runs.
+		for (const TautRope::FContactChain& Chain : TautRope::GetContactChains(RopePoints, NearbyShapes))
+		{
+			TautRope::SolveContactChain(Chain, RopePoints, NearbyShapes[Chain.ShapeIndex], RopeTargetLocations);
+		}
+	}
+	// Points on a fan of edges around one vertex are straightened together, the rest slide along their edge on their own.
+	const TArray<TautRope::FMovementGroup> MovementGroups = TautRope::GetMovementGroups(RopePoints, NearbyShapes);
+	int32 NextGroupIndex = 0;
 	for (int32 i = 1; i < RopePoints.Num() - 1; ++i)
 	{
+		if (MovementGroups.IsValidIndex(NextGroupIndex) && MovementGroups[NextGroupIndex].FirstPointIndex == i)
+		{
+			const TautRope::FMovementGroup& Group = MovementGroups[NextGroupIndex++];
+			const bool bIsGroupSolved = TautRope::SolveMovementGroup(
+				Group
+				, NearbyShapes[Group.ShapeIndex]
+				, RopeTargetLocations[i - 1]
+				, RopeTargetLocations[Group.LastPointIndex + 1]
+				, RopeTargetLocations
+			);
+			if (bIsGroupSolved)
+			{
+				i = Group.LastPointIndex;
+				continue;
+			}
+		}
 		TautRope::FPoint& PointB = RopePoints[i];
 		if (PointB.VertIndex != INDEX_NONE)
 		{
 			continue;
 		}
+		const FTautRopeCollisionShape& Shape = NearbyShapes[PointB.ShapeIndex];
+		if (Shape.IsCurved())
+		{
+			// Entry and exit are placed analytically, the arc between them is never swept.
+			if (TautRope::IsCurvedWrapSegment(RopePoints, i, NearbyShapes))
+			{
+				TautRope::SolveCurvedWrap(
+					Shape
+					, RopeTargetLocations[i - 1]
+					, RopeTargetLocations[i + 2]
+					, PointB.Location
+					, RopePoints[i + 1].Location
+					, RopeTargetLocations[i]
+					, RopeTargetLocations[i + 1]
+				);
+				++i;
+			}
+			continue;
+		}
 		const FVector& LocationA = RopeTargetLocations[i - 1];
 		const FVector& LocationC = RopeTargetLocations[i + 1];
-		const FTautRopeCollisionShape& Shape = NearbyShapes[PointB.ShapeIndex];
-		const FIntVector2& Edge = Shape.Edges[PointB.EdgeIndex];
+		const FIntVector2& Edge = Shape.GetGeometry().Edges[PointB.EdgeIndex];
 		const bool bIsEdgeCornerAtVertexA = NearbyShapes[PointB.ShapeIndex].IsCornerVertex(Edge.X);
 		const bool bIsEdgeCornerAtVertexB = NearbyShapes[PointB.ShapeIndex].IsCornerVertex(Edge.Y);
-		const FVector& EdgeVertA = Shape.Vertices[Edge.X];
-		const FVector& EdgeVertB = Shape.Vertices[Edge.Y];
+		const FVector EdgeVertA = Shape.GetVertex(Edge.X);
+		const FVector EdgeVertB = Shape.GetVertex(Edge.Y);
 		float OutDistAlongEdge = 0.f;
 		float OutEdgeLength = 0.f;
 		const FVector PrevRopeTargetLocation = RopeTargetLocations[i];
 		const FVector RopeTargetLocation = TautRope::FindMinDistancePointBetweenABOnLineXY(LocationA, LocationC, EdgeVertA, EdgeVertB, OutDistAlongEdge, OutEdgeLength);
 
-		// Used to get a normalized vector inbetween two unit length orthogonal vectors.
-		constexpr float INV_SQRT2 = 0.70710678f;
-
 		if (!bIsEdgeCornerAtVertexA && OutDistAlongEdge < TAUT_ROPE_DISTANCE_TOLERANCE)
 		{
 			PointB.VertIndex = Edge.X;
-			const FQuat& EdgeRotation = Shape.EdgeRotations[PointB.EdgeIndex];
-			RopeTargetLocations[i] = EdgeVertA + (EdgeRotation.GetUpVector() - EdgeRotation.GetForwardVector()) * INV_SQRT2 * TAUT_ROPE_VERTEX_CROSSING_OFFSET;
+			RopeTargetLocations[i] = TautRope::GetVertexCrossingLocation(Shape, PointB.EdgeIndex, PointB.VertIndex);
 		}
 		else if (!bIsEdgeCornerAtVertexB && OutDistAlongEdge > OutEdgeLength - TAUT_ROPE_DISTANCE_TOLERANCE)
 		{
 			PointB.VertIndex = Edge.Y;
-			const FQuat& EdgeRotation = Shape.EdgeRotations[PointB.EdgeIndex];
-			RopeTargetLocations[i] = EdgeVertB + (EdgeRotation.GetUpVector() + EdgeRotation.GetForwardVector()) * INV_SQRT2 * TAUT_ROPE_VERTEX_CROSSING_OFFSET;
+			RopeTargetLocations[i] = TautRope::GetVertexCrossingLocation(Shape, PointB.EdgeIndex, PointB.VertIndex);
 		}
 		else
 		{
@@ -172,26 +926,39 @@ TArray<FVector> FTautRope::MovementPhase(
 }
 
 bool FTautRope::CollisionPhase(
-	TArray<FVector>& TargetRopePoints
+	int32& InOutIterationBudget
+	, const double DeadlineSeconds
 #if TAUT_ROPE_DEBUG_DRAWING
 	, const UWorld* World
 #endif // TAUT_ROPE_DEBUG_DRAWING
 )
 {
-	TArray<FVector> OriginRopePoints;
-	OriginRopePoints.SetNum(RopePoints.Num());
-	for (int32 i = 0; i < RopePoints.Num(); ++i)
-	{
-		OriginRopePoints[i] = RopePoints[i].Location;
-	}
+	TArray<FVector>& OriginRopePoints = CollisionSolve.OriginRopePoints;
+	TArray<FVector>& TargetRopePoints = CollisionSolve.TargetRopePoints;
+	TBitArray<>& PendingSegments = CollisionSolve.PendingSegments;
 
-	int32 CollisionItr = 0;
-	bool bIsAnyNewCollision = true;
-	while (bIsAnyNewCollision && CollisionItr < TAUT_ROPE_MAX_COLLISION_ITERATIONS)
+	bool bHasRunIteration = false;
+	while (PendingSegments.Contains(true) && CollisionSolve.Iterations < TAUT_ROPE_MAX_COLLISION_ITERATIONS)
 	{
+		// Always make progress, but leave the rest of the solve to later updates once out of budget.
+		if (bHasRunIteration && (InOutIterationBudget <= 0 || FPlatformTime::Seconds() > DeadlineSeconds))
+		{
+			return false;
+		}
+		bHasRunIteration = true;
+		InOutIterationBudget--;
+
 		TArray<TautRope::FHitData> SegmentSweepHits;
+		TArray<TautRope::FHitData> HitChain;
+		const int32 MaxHitsPerSweep = FMath::Max(CVarCollisionMaxHitsPerSweep.GetValueOnGameThread(), 1);
+		const int32 LocalSearchHops = CVarCollisionLocalSearchHops.GetValueOnGameThread();
+		TBitArray<> DirtyPoints(false, RopePoints.Num());
 		for (int32 i = 0; i < RopePoints.Num() - 1; ++i)
 		{
+			if (!PendingSegments[i] || TautRope::IsCurvedWrapSegment(RopePoints, i, NearbyShapes))
+			{
+				continue;
+			}
 			TautRope::FPoint& SegmentPointA = RopePoints[i];
 			TautRope::FPoint& SegmentPointB = RopePoints[i + 1];
 			const FVector& OriginLocationA = OriginRopePoints[i];
@@ -199,9 +966,8 @@ bool FTautRope::CollisionPhase(
 			const FVector& TargetLocationA = TargetRopePoints[i];
 			const FVector& TargetLocationB = TargetRopePoints[i + 1];
 
-			TautRope::FHitData HitData;
 			TautRope::SweepSegmentThroughShapes(
-				HitData
+				HitChain
 				, SegmentPointA
 				, SegmentPointB
 				, OriginLocationA
@@ -210,14 +976,16 @@ bool FTautRope::CollisionPhase(
 				, TargetLocationB
 				, NearbyShapes
 				, i + 1
+				, MaxHitsPerSweep
+				, LocalSearchHops
 #if TAUT_ROPE_DEBUG_DRAWING
 				, World
 				, CVarDrawDebugSegmentSweep.GetValueOnGameThread() != 0
 #endif
 			);
-			if (HitData.bIsHit)
+			if (!HitChain.IsEmpty())
 			{
-				if (HitData.bIsHitOnFirstTriangleSweep)
+				if (HitChain[0].bIsHitOnFirstTriangleSweep)
 				{
 					SegmentPointA.VertIndex = INDEX_NONE;
 				}
@@ -225,20 +993,34 @@ bool FTautRope::CollisionPhase(
 				{
 					SegmentPointB.VertIndex = INDEX_NONE;
 				}
-				SegmentSweepHits.Add(MoveTemp(HitData));
+				DirtyPoints[i] = true;
+				DirtyPoints[i + 1] = true;
+				// The chain is in rope order, and the reverse insertion below keeps hits sharing an index in that order.
+				SegmentSweepHits.Append(HitChain);
 			}
 		}
 		for (int32 i = SegmentSweepHits.Num() - 1; i >= 0; --i)
 		{
 			const TautRope::FHitData& HitData = SegmentSweepHits[i];
 			RopePoints.Insert(TautRope::FPoint(HitData), HitData.RopePointIndex);
-			OriginRopePoints.Insert(HitData.Location, HitData.RopePointIndex);
+			// The origin of a point on a moving shape is where it was on the shape before this step. Chained points start
+			// where the rope began bending towards them, so the segments between them sweep what the chain swept past.
+			const FVector OriginLocation = HitData.bIsChained
+				? HitData.ChainOriginLocation
+				: NearbyShapes[HitData.ShapeIndex].MoveBackWithShape(HitData.Location);
+			OriginRopePoints.Insert(OriginLocation, HitData.RopePointIndex);
 			TargetRopePoints.Insert(HitData.Location, HitData.RopePointIndex);
+			DirtyPoints.Insert(true, HitData.RopePointIndex);
+		}
+		// Settled segments sweep the same way again, so only the ones touching a changed point are re-swept.
+		PendingSegments.Init(false, RopePoints.Num() - 1);
+		for (int32 i = 0; i < RopePoints.Num() - 1; ++i)
+		{
+			PendingSegments[i] = DirtyPoints[i] || DirtyPoints[i + 1];
 		}
-		bIsAnyNewCollision = !SegmentSweepHits.IsEmpty();
-		CollisionItr++;
+		CollisionSolve.Iterations++;
 	}
-	return false;
+	return true;
 }
 
 bool FTautRope::PruningPhase(
@@ -258,12 +1040,24 @@ bool FTautRope::PruningPhase(
 		const TautRope::FPoint& Point = RopePoints[i];
 		const TautRope::FPoint& NextPoint = RopePoints[i + 1];
 		const FTautRopeCollisionShape& Shape = NearbyShapes[Point.ShapeIndex];
+		if (Shape.IsCurved())
+		{
+			// A curved contact or wrap unwinds once the straight line past it clears the shape.
+			const int32 WrapEndIndex = TautRope::IsCurvedWrapSegment(RopePoints, i, NearbyShapes) ? i + 1 : i;
+			if (TautRope::IsSegmentClearOfCurvedShape(LastPoint.Location, RopePoints[WrapEndIndex + 1].Location, Shape))
+			{
+				PointsToRemove[i] = true;
+				PointsToRemove[WrapEndIndex] = true;
+			}
+			i = WrapEndIndex;
+			continue;
+		}
 		if (Point.ShapeIndex == LastPoint.ShapeIndex && Point.EdgeIndex == LastPoint.EdgeIndex)
 		{
 			PointsToRemove[i] = true;
 			continue;
 		}
-		const FQuat& EdgeRotation = Shape.EdgeRotations[Point.EdgeIndex];
+		const FQuat EdgeRotation = Shape.GetEdgeRotation(Point.EdgeIndex);
 		const bool bIsRopeWrappingEdge = TautRope::IsRopeWrappingEdge(
 			LastPoint.Location
 			, Point.Location
@@ -277,7 +1071,17 @@ bool FTautRope::PruningPhase(
 	}
 	for (int32 i = RopePoints.Num() - 2; i > 0; --i)
 	{
-		if (PointsToRemove[i])
+		if (!PointsToRemove[i])
+		{
+			continue;
+		}
+		// Runs of removable points, like an unwrapping vertex cone, are removed together.
+		const int32 LastRemoveIndex = i;
+		while (i > 1 && PointsToRemove[i - 1])
+		{
+			--i;
+		}
+		if (i == LastRemoveIndex)
 		{
 			TautRope::SweepRemovePoint(
 				RopePoints
@@ -288,7 +1092,19 @@ bool FTautRope::PruningPhase(
 				, CVarDrawDebugRemoveSweep.GetValueOnGameThread() != 0
 #endif
 			);
+			continue;
 		}
+		TautRope::SweepRemovePoints(
+			RopePoints
+			, i
+			, LastRemoveIndex
+			, NearbyShapes
+			, NearbyShapeBounds
+#if TAUT_ROPE_DEBUG_DRAWING
+			, World
+			, CVarDrawDebugRemoveSweep.GetValueOnGameThread() != 0
+#endif
+		);
 	}
 	return PointsToRemove.Contains(true);
 }
@@ -319,18 +1135,18 @@ void FTautRope::DrawDebugRope(const UWorld* World) const
 	{
 		FVector UpOffsetA = FVector::ZeroVector;
 		FVector UpOffsetB = FVector::ZeroVector;
-		if (RopePoints[i].ShapeIndex != INDEX_NONE)
+		if (RopePoints[i].EdgeIndex != INDEX_NONE)
 		{
 			const FTautRopeCollisionShape& ShapeA = NearbyShapes[RopePoints[i].ShapeIndex];
-			UpOffsetA = ShapeA.EdgeRotations[RopePoints[i].EdgeIndex].GetUpVector() * TAUT_ROPE_DISTANCE_TOLERANCE;
+			UpOffsetA = ShapeA.GetEdgeRotation(RopePoints[i].EdgeIndex).GetUpVector() * TAUT_ROPE_DISTANCE_TOLERANCE;
 		}
 
 		if (RopePoints.IsValidIndex(i + 1))
 		{
-			if (RopePoints[i + 1].ShapeIndex != INDEX_NONE)
+			if (RopePoints[i + 1].EdgeIndex != INDEX_NONE)
 			{
 				const FTautRopeCollisionShape& ShapeB = NearbyShapes[RopePoints[i + 1].ShapeIndex];
-				UpOffsetB = ShapeB.EdgeRotations[RopePoints[i + 1].EdgeIndex].GetUpVector() * TAUT_ROPE_DISTANCE_TOLERANCE;
+				UpOffsetB = ShapeB.GetEdgeRotation(RopePoints[i + 1].EdgeIndex).GetUpVector() * TAUT_ROPE_DISTANCE_TOLERANCE;
 			}
 			DrawDebugLine(
 				World
@@ -358,15 +1174,15 @@ void FTautRope::DrawDebugRopeTouchedShapeEdges(const UWorld* World) const
 {
 	for (int32 i = 0; i < RopePoints.Num(); ++i)
 	{
-		if (RopePoints[i].ShapeIndex != INDEX_NONE)
+		if (RopePoints[i].EdgeIndex != INDEX_NONE)
 		{
 			const FTautRopeCollisionShape& Shape = NearbyShapes[RopePoints[i].ShapeIndex];
 			const int32 EdgeIndex = RopePoints[i].EdgeIndex;
-			const int32 EdgeVertIndexA = Shape.Edges[EdgeIndex].X;
-			const int32 EdgeVertIndexB = Shape.Edges[EdgeIndex].Y;
-			const FVector EdgeVertA = Shape.Vertices[EdgeVertIndexA];
-			const FVector EdgeVertB = Shape.Vertices[EdgeVertIndexB];
-			const FVector UpOffset = Shape.EdgeRotations[EdgeIndex].GetUpVector() * TAUT_ROPE_DISTANCE_TOLERANCE;
+			const int32 EdgeVertIndexA = Shape.GetGeometry().Edges[EdgeIndex].X;
+			const int32 EdgeVertIndexB = Shape.GetGeometry().Edges[EdgeIndex].Y;
+			const FVector EdgeVertA = Shape.GetVertex(EdgeVertIndexA);
+			const FVector EdgeVertB = Shape.GetVertex(EdgeVertIndexB);
+			const FVector UpOffset = Shape.GetEdgeRotation(EdgeIndex).GetUpVector() * TAUT_ROPE_DISTANCE_TOLERANCE;
 			DrawDebugLine(
 				World
 				, EdgeVertA + UpOffset
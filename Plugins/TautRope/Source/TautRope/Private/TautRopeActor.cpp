@@ -2,15 +2,53 @@
 #include "TautRope.h"
 #include "TautRopeConfig.h"
 #include "TautRopeCollisionVolumeActor.h"
+#include "TautRopeMeshComponent.h"
+#include "TautRopeModule.h"
+#include "TautRopeRecording.h"
+#include "TautRopeSubsystem.h"
 
 #include "Components/SceneComponent.h"
 #include "Components/BillboardComponent.h"
 #include "UObject/ConstructorHelpers.h"
 #include "Kismet/KismetSystemLibrary.h"
+#include "Camera/PlayerCameraManager.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "EngineUtils.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+#include "Net/UnrealNetwork.h"
+
+static FAutoConsoleCommandWithWorldAndArgs CmdTautRopeRecord(
+	TEXT("TautRope.Record"),
+	TEXT("Starts or stops recording all taut ropes in the world.\n")
+	TEXT("Usage: TautRope.Record <1|0>"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (!IsValid(World))
+			{
+				return;
+			}
+			const bool bStart = Args.IsEmpty() || FCString::Atoi(*Args[0]) != 0;
+			for (TActorIterator<ATautRopeActor> It(World); It; ++It)
+			{
+				if (bStart)
+				{
+					It->StartRecording();
+				}
+				else
+				{
+					It->StopRecording();
+				}
+			}
+		})
+);
 
 ATautRopeActor::ATautRopeActor()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	// Simulation is driven by UTautRopeSubsystem.
+	PrimaryActorTick.bCanEverTick = false;
+	bReplicates = true;
 
 	USceneComponent* Root = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
 	RootComponent = Root;
@@ -20,6 +58,8 @@ ATautRopeActor::ATautRopeActor()
 	EndPoint->SetupAttachment(RootComponent);
 	StartPoint->SetRelativeLocation(FVector(0.f, 0.f, 0.f));
 	EndPoint->SetRelativeLocation(FVector(0.f, MaxLength, 0.f));
+	RopeMesh = CreateDefaultSubobject<UTautRopeMeshComponent>(TEXT("RopeMesh"));
+	RopeMesh->SetupAttachment(RootComponent);
 
 #if WITH_EDITORONLY_DATA
 	static ConstructorHelpers::FObjectFinder<UTexture2D> StartSpriteFinder(TEXT("/Engine/EditorResources/Waypoint"));
@@ -44,10 +84,46 @@ ATautRopeActor::ATautRopeActor()
 }
 
 
+void ATautRopeActor::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(ATautRopeActor, ReplicatedState);
+}
+
 void ATautRopeActor::BeginPlay()
 {
-    Super::BeginPlay();
+	Super::BeginPlay();
+
+	GatherNearbyShapes(TautRope);
+	RopeSnapshot.Restore(TautRope, MaxLength);
+
+	TautRope.OnContactAdded.AddUObject(this, &ATautRopeActor::HandleContactAdded);
+	TautRope.OnContactRemoved.AddUObject(this, &ATautRopeActor::HandleContactRemoved);
+
+	if (UTautRopeSubsystem* Subsystem = GetWorld()->GetSubsystem<UTautRopeSubsystem>())
+	{
+		Subsystem->RegisterRope(this);
+	}
+}
+
+void ATautRopeActor::Serialize(FArchive& Ar)
+{
+	if (Ar.IsSaveGame() && Ar.IsSaving() && HasActorBegunPlay())
+	{
+		RopeSnapshot.Capture(TautRope);
+	}
+
+	Super::Serialize(Ar);
+
+	if (Ar.IsSaveGame() && Ar.IsLoading() && HasActorBegunPlay())
+	{
+		RopeSnapshot.Restore(TautRope, MaxLength);
+	}
+}
 
+void ATautRopeActor::GatherNearbyShapes(FTautRope& Rope) const
+{
     TArray<AActor*> OverlappingActors;
     UKismetSystemLibrary::SphereOverlapActors(
         GetWorld(),
@@ -64,25 +140,394 @@ void ATautRopeActor::BeginPlay()
         const ATautRopeCollisionVolumeActor* TautRopeCollisionVolumeActor = Cast<ATautRopeCollisionVolumeActor>(Actor);
         if (IsValid(TautRopeCollisionVolumeActor))
         {
-			TautRope.AppendToNearbyShapes(TautRopeCollisionVolumeActor->GetStaticShapes());
+			Rope.AppendToNearbyShapes(TautRopeCollisionVolumeActor->GetStaticShapes());
+			Rope.AppendToNearbyShapes(TautRopeCollisionVolumeActor->GetMovableShapes());
+			Rope.AppendToNearbyShapes(TautRopeCollisionVolumeActor->GetInstanceShapes());
         }
     }
 }
 
-void ATautRopeActor::Tick(float DeltaTime)
+void ATautRopeActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UTautRopeSubsystem* Subsystem = GetWorld()->GetSubsystem<UTautRopeSubsystem>())
+	{
+		Subsystem->UnregisterRope(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ATautRopeActor::AdvanceSchedule(float DeltaTime)
+{
+	FramesSinceUpdate++;
+	TimeSinceUpdate += DeltaTime;
+	TimeSinceDisturbed += DeltaTime;
+	UpdateLOD = CalcUpdateLOD(bIsOnScreen);
+}
+
+ETautRopeUpdateLOD ATautRopeActor::CalcUpdateLOD(bool& bOutIsOnScreen) const
+{
+	bOutIsOnScreen = true;
+	const UTautRopeSettings* Settings = GetDefault<UTautRopeSettings>();
+	const UWorld* World = GetWorld();
+	if (!IsValid(World) || SolvedRopePoints.IsEmpty())
+	{
+		return ETautRopeUpdateLOD::Full;
+	}
+	const FTautRopeLODSettings& LOD = bOverrideLODSettings ? LODSettings : Settings->DefaultLODSettings;
+
+	const FBox RopeBounds(SolvedRopePoints);
+	const FVector RopeCenter = RopeBounds.GetCenter();
+	const float RopeRadius = RopeBounds.GetExtent().Size();
+
+	bool bHasCamera = false;
+	bool bIsInAnyView = false;
+	float MinDistanceSquared = MAX_FLT;
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		if (!IsValid(PlayerController) || !IsValid(PlayerController->PlayerCameraManager))
+		{
+			continue;
+		}
+		const APlayerCameraManager* CameraManager = PlayerController->PlayerCameraManager;
+		const FVector CameraLocation = CameraManager->GetCameraLocation();
+		bHasCamera = true;
+		MinDistanceSquared = FMath::Min(MinDistanceSquared, static_cast<float>(RopeBounds.ComputeSquaredDistanceToPoint(CameraLocation)));
+
+		// Cone test against the horizontal field of view, widened by the angular size of the rope bounds.
+		const FVector ToRope = RopeCenter - CameraLocation;
+		const float DistanceToCenter = ToRope.Size();
+		if (DistanceToCenter <= RopeRadius)
+		{
+			bIsInAnyView = true;
+			continue;
+		}
+		const float HalfFOVRadians = FMath::DegreesToRadians(CameraManager->GetFOVAngle() * 0.5f);
+		const float BoundsHalfAngle = FMath::Asin(RopeRadius / DistanceToCenter);
+		const float CosToRope = FVector::DotProduct(ToRope / DistanceToCenter, CameraManager->GetCameraRotation().Vector());
+		if (CosToRope >= FMath::Cos(FMath::Min(HalfFOVRadians + BoundsHalfAngle, UE_PI)))
+		{
+			bIsInAnyView = true;
+		}
+	}
+	if (!bHasCamera)
+	{
+		return ETautRopeUpdateLOD::Full;
+	}
+	// The renderer only marks primitives that pass its occlusion culling as rendered on screen. Dedicated servers never
+	// render, so there ropes in view stay on screen.
+	if (bIsInAnyView
+		&& LOD.bOccludedIsOffScreen
+		&& World->GetNetMode() != NM_DedicatedServer
+		&& IsValid(RopeMesh)
+		&& RopeMesh->IsVisible()
+		&& GetGameTimeSinceCreation() > LOD.OccludedDelay
+		&& !RopeMesh->WasRecentlyRendered(LOD.OccludedDelay))
+	{
+		bIsInAnyView = false;
+	}
+	bOutIsOnScreen = bIsInAnyView;
+	if (!Settings->bEnableUpdateLOD)
+	{
+		return ETautRopeUpdateLOD::Full;
+	}
+	if (!bIsInAnyView && LOD.bOffScreenIsFar)
+	{
+		return ETautRopeUpdateLOD::Far;
+	}
+	if (MinDistanceSquared <= FMath::Square(LOD.FullRateDistance))
+	{
+		return ETautRopeUpdateLOD::Full;
+	}
+	if (MinDistanceSquared <= FMath::Square(LOD.ReducedRateDistance))
+	{
+		return ETautRopeUpdateLOD::Reduced;
+	}
+	return ETautRopeUpdateLOD::Far;
+}
+
+bool ATautRopeActor::IsUpdateDue() const
+{
+	const FTautRopeLODSettings& LOD = bOverrideLODSettings ? LODSettings : GetDefault<UTautRopeSettings>()->DefaultLODSettings;
+	switch (UpdateLOD)
+	{
+		case ETautRopeUpdateLOD::Reduced:
+		{
+			return FramesSinceUpdate >= LOD.ReducedRateFrameInterval;
+		}
+		case ETautRopeUpdateLOD::Far:
+		{
+			return TimeSinceUpdate * FMath::Max(LOD.FarUpdateRate, KINDA_SMALL_NUMBER) >= 1.f;
+		}
+		default:
+		{
+			return true;
+		}
+	}
+}
+
+float ATautRopeActor::GetUpdateImportance() const
 {
-	Super::Tick(DeltaTime);
-	
-	TautRope.UpdateRope(
-		StartPoint->GetComponentLocation()
-		, EndPoint->GetComponentLocation()
-		, MaxLength
+	float Importance = 0.f;
+	if (IsAttachedToPlayer())
+	{
+		Importance += 4.f;
+	}
+	if (bIsOnScreen)
+	{
+		Importance += 2.f;
+	}
+	if (TimeSinceDisturbed < GetDefault<UTautRopeSettings>()->DisturbedDuration)
+	{
+		Importance += 1.f;
+	}
+	return Importance;
+}
+
+bool ATautRopeActor::IsAttachedToPlayer() const
+{
+	for (const AActor* Parent = GetAttachParentActor(); IsValid(Parent); Parent = Parent->GetAttachParentActor())
+	{
+		const APawn* Pawn = Cast<APawn>(Parent);
+		if (IsValid(Pawn) && Pawn->IsPlayerControlled())
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void ATautRopeActor::AppendRopeSegments(
+	const int32 RopeId
+	, TArray<TautRope::FRopeSegment>& OutSegments
+)
+{
+	if (!bCollidesWithRopes)
+	{
+		return;
+	}
+	if (!TautRope.IsCollisionSolveActive())
+	{
+		CachedRopeSegments.Reset();
+		TautRope::AppendRopeSegments(TautRope.GetPoints(), TautRope.GetNearbyShapes(), RopeId, RopeMesh->Radius, CachedRopeSegments);
+	}
+	OutSegments.Append(CachedRopeSegments);
+}
+
+void ATautRopeActor::UpdateForeignRopeSegments(
+	const TautRope::FRopeSegmentTree& SegmentTree
+	, const int32 RopeId
+)
+{
+	if (!bCollidesWithRopes)
+	{
+		return;
+	}
+	FBox Bounds(TautRope.GetRopeLocations().GetData(), TautRope.GetRopeLocations().Num());
+	Bounds += StartPoint->GetComponentLocation();
+	Bounds += EndPoint->GetComponentLocation();
+	TArray<int32> SegmentIndices;
+	SegmentTree.Query(Bounds.ExpandBy(RopeMesh->Radius), SegmentIndices);
+
+	TArray<TautRope::FRopeSegment> ForeignSegments;
+	ForeignSegments.Reserve(SegmentIndices.Num());
+	for (const int32 SegmentIndex : SegmentIndices)
+	{
+		const TautRope::FRopeSegment& Segment = SegmentTree.GetSegment(SegmentIndex);
+		// Clients only place the contacts the server sent on these capsules, and rope ids are handed out in another order
+		// there, so they keep every other rope's segments.
+		const bool bIsWrappable = HasAuthority() ? Segment.RopeId < RopeId : Segment.RopeId != RopeId;
+		if (bIsWrappable)
+		{
+			// The solver treats this rope as a line, so its thickness goes onto the foreign capsule.
+			TautRope::FRopeSegment& ForeignSegment = ForeignSegments.Add_GetRef(Segment);
+			ForeignSegment.Radius += RopeMesh->Radius;
+		}
+	}
+	TautRope.SetForeignRopeSegments(ForeignSegments);
+}
+
+void ATautRopeActor::UpdateSimulation()
+{
+	const FVector StartLocation = StartPoint->GetComponentLocation();
+	const FVector EndLocation = EndPoint->GetComponentLocation();
+	if (SolvedRopePoints.Num() < 2
+		|| !LastStartLocation.Equals(StartLocation, TAUT_ROPE_DISTANCE_TOLERANCE)
+		|| !LastEndLocation.Equals(EndLocation, TAUT_ROPE_DISTANCE_TOLERANCE))
+	{
+		TimeSinceDisturbed = 0.f;
+	}
+	LastStartLocation = StartLocation;
+	LastEndLocation = EndLocation;
+
+	if (HasAuthority())
+	{
+		TautRope.UpdateRope(
+			StartLocation
+			, EndLocation
+			, MaxLength
 #if TAUT_ROPE_DEBUG_DRAWING
-		, GetWorld()
+			, GetWorld()
 #endif // TAUT_ROPE_DEBUG_DRAWING
-		);
+			);
+		if (GetNetMode() != NM_Standalone && !TautRope.IsCollisionSolveActive())
+		{
+			ReplicatedState.SetFromRopePoints(TautRope.GetPoints(), TautRope.GetNearbyShapes());
+		}
+	}
+	else if (ReplicatedState.ConsumeReceivedState())
+	{
+		TautRope.ResetRopePoints(ReplicatedState.ToRopePoints(TautRope.GetNearbyShapes()), MaxLength);
+	}
+
+	// A rope at rest has nothing left to interpolate.
+	bIsSolvedPathAtRest = SolvedPathVersion == TautRope.GetPathVersion();
+	if (!bIsSolvedPathAtRest)
+	{
+		SolvedPathVersion = TautRope.GetPathVersion();
+		Swap(PrevSolvedRopePoints, SolvedRopePoints);
+		Swap(PrevSolvedRopeFeatures, SolvedRopeFeatures);
+		const TConstArrayView<FVector> RopeLocations = TautRope.GetRopeLocations();
+		SolvedRopePoints.Reset();
+		SolvedRopePoints.Append(RopeLocations.GetData(), RopeLocations.Num());
+		const TConstArrayView<FIntVector> RopeFeatures = TautRope.GetRopeFeatures();
+		SolvedRopeFeatures.Reset();
+		SolvedRopeFeatures.Append(RopeFeatures.GetData(), RopeFeatures.Num());
+	}
+	LastUpdateInterval = TimeSinceUpdate;
+	FramesSinceUpdate = 0;
+	TimeSinceUpdate = 0.f;
+}
+
+void ATautRopeActor::PublishRopePoints()
+{
+	// Interpolating lags the simulation by one update interval, which is only worth it while updates are skipped. Points
+	// are only blended with the point on the same contact, a rope that wrapped or unwrapped snaps to its new path.
+	const bool bCanInterpolate = UpdateLOD != ETautRopeUpdateLOD::Full
+		&& !bIsSolvedPathAtRest
+		&& LastUpdateInterval > KINDA_SMALL_NUMBER
+		&& PrevSolvedRopeFeatures == SolvedRopeFeatures;
+	if (!bCanInterpolate)
+	{
+		PublishedRopePoints = SolvedRopePoints;
+	}
+	else
+	{
+		const float Alpha = FMath::Clamp(TimeSinceUpdate / LastUpdateInterval, 0.f, 1.f);
+		PublishedRopePoints.SetNum(SolvedRopePoints.Num());
+		for (int32 i = 0; i < SolvedRopePoints.Num(); ++i)
+		{
+			PublishedRopePoints[i] = FMath::Lerp(PrevSolvedRopePoints[i], SolvedRopePoints[i], Alpha);
+		}
+	}
+	RopeMesh->SetRopePoints(PublishedRopePoints);
 
 #if TAUT_ROPE_DEBUG_DRAWING
 	TautRope.DrawDebug(GetWorld());
 #endif // TAUT_ROPE_DEBUG_DRAWING
-}
\ No newline at end of file
+}
+
+float ATautRopeActor::GetRopeLength() const
+{
+	return TautRope.GetLength();
+}
+
+float ATautRopeActor::GetRopeSlack() const
+{
+	return TautRope.GetSlack();
+}
+
+FVector ATautRopeActor::GetLocationAtDistance(float Distance) const
+{
+	return TautRope.GetLocationAtDistance(Distance);
+}
+
+FVector ATautRopeActor::GetTangentAtDistance(float Distance) const
+{
+	return TautRope.GetTangentAtDistance(Distance);
+}
+
+float ATautRopeActor::GetDistanceClosestToLocation(const FVector& Location) const
+{
+	return TautRope.GetDistanceClosestToLocation(Location);
+}
+
+int32 ATautRopeActor::GetRopePathVersion() const
+{
+	return static_cast<int32>(TautRope.GetPathVersion());
+}
+
+void ATautRopeActor::HandleContactAdded(const int32 ShapeIndex, const FVector& Location)
+{
+	OnContactAdded.Broadcast(Location);
+}
+
+void ATautRopeActor::HandleContactRemoved(const int32 ShapeIndex, const FVector& Location)
+{
+	OnContactRemoved.Broadcast(Location);
+}
+
+void ATautRopeActor::StartRecording()
+{
+	TautRope.StartRecording();
+}
+
+FString ATautRopeActor::StopRecording()
+{
+	TSharedPtr<TautRope::FRecording> Recording = TautRope.StopRecording();
+	if (!Recording.IsValid())
+	{
+		return FString();
+	}
+	const FString FilePath = TautRope::GetRecordingsDir() / FString::Printf(
+		TEXT("%s_%s.trrec")
+		, *GetName()
+		, *FDateTime::Now().ToString()
+	);
+	if (!Recording->SaveToFile(FilePath))
+	{
+		UE_LOG(LogTautRope, Warning, TEXT("Failed to save rope recording %s"), *FilePath);
+		return FString();
+	}
+	UE_LOG(LogTautRope, Display, TEXT("Saved rope recording with %d frames to %s"), Recording->Frames.Num(), *FilePath);
+	return FilePath;
+}
+#if WITH_EDITOR
+void ATautRopeActor::BakeRopeSnapshot()
+{
+	FTautRope BakeRope;
+	GatherNearbyShapes(BakeRope);
+	const FVector StartLocation = StartPoint->GetComponentLocation();
+	const FVector EndLocation = EndPoint->GetComponentLocation();
+	uint32 PrevPathVersion = 0;
+	for (int32 UpdateIndex = 0; UpdateIndex < TAUT_ROPE_SNAPSHOT_BAKE_MAX_UPDATES; ++UpdateIndex)
+	{
+		BakeRope.UpdateRope(
+			StartLocation
+			, EndLocation
+			, MaxLength
+#if TAUT_ROPE_DEBUG_DRAWING
+			, GetWorld()
+#endif // TAUT_ROPE_DEBUG_DRAWING
+		);
+		if (!BakeRope.IsCollisionSolveActive() && BakeRope.GetPathVersion() == PrevPathVersion)
+		{
+			break;
+		}
+		PrevPathVersion = BakeRope.GetPathVersion();
+	}
+	Modify();
+	if (!RopeSnapshot.Capture(BakeRope))
+	{
+		UE_LOG(LogTautRope, Warning, TEXT("%s did not settle within %d updates, no snapshot was baked"), *GetName(), TAUT_ROPE_SNAPSHOT_BAKE_MAX_UPDATES);
+		RopeSnapshot.Reset();
+	}
+}
+
+void ATautRopeActor::ClearRopeSnapshot()
+{
+	Modify();
+	RopeSnapshot.Reset();
+}
+#endif
\ No newline at end of file
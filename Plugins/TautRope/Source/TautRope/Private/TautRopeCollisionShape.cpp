@@ -1,7 +1,12 @@
 #include "TautRopeCollisionShape.h"
 #include "PhysicsEngine/BodySetup.h"
+#include "PhysicsEngine/BoxElem.h"
 #include "PhysicsEngine/ConvexElem.h"
+#include "PhysicsEngine/SphereElem.h"
+#include "PhysicsEngine/SphylElem.h"
 #include "Components/PrimitiveComponent.h"
+#include "Components/SceneComponent.h"
+#include "Engine/Level.h"
 
 FTautRopeCollisionShape::FTautRopeCollisionShape(
 	const FKConvexElem& Convex
@@ -47,27 +52,70 @@ FTautRopeCollisionShape::FTautRopeCollisionShape(
 		EdgeIndexToTriangles.FindOrAdd(EdgeIndexC).Add(Tri);
 	}
 
-	PopulateVertToEdges();
+	// Hulls are not always wound consistently, so triangle normals are turned away from the centroid.
+	FVector Centroid = FVector::ZeroVector;
+	for (const FVector& Vert : Vertices)
+	{
+		Centroid += Vert;
+	}
+	Centroid /= FMath::Max(Vertices.Num(), 1);
 
-	EdgeRotations.SetNum(Edges.Num());
-	for (auto [EdgeIndex, NeighborTriangles] : EdgeIndexToTriangles)
+	// Only feature edges are kept. Edges between coplanar triangles are diagonals of a flat face, which a rope never wraps.
+	TArray<FIntVector2> FeatureEdges;
+	TArray<FQuat> FeatureEdgeRotations;
+	for (int32 EdgeIndex = 0; EdgeIndex < Edges.Num(); ++EdgeIndex)
 	{
-		if (!ensure(!NeighborTriangles.IsEmpty()))
+		const TArray<FIntVector>* NeighborTriangles = EdgeIndexToTriangles.Find(EdgeIndex);
+		if (!ensure(NeighborTriangles && !NeighborTriangles->IsEmpty()))
 		{
 			continue;
 		}
+		TArray<FVector, TInlineAllocator<2>> TriangleNormals;
 		FVector TriangleNormalSum = FVector::ZeroVector;
-		for (const FIntVector& NeighborTriangle : NeighborTriangles)
+		for (const FIntVector& NeighborTriangle : *NeighborTriangles)
 		{
 			const FVector& A = Vertices[NeighborTriangle.X];
 			const FVector& B = Vertices[NeighborTriangle.Y];
 			const FVector& C = Vertices[NeighborTriangle.Z];
-			TriangleNormalSum += FVector::CrossProduct(B - A, C - A).GetSafeNormal();
+			FVector Normal = FVector::CrossProduct(B - A, C - A).GetSafeNormal();
+			if (FVector::DotProduct(Normal, A - Centroid) < 0.)
+			{
+				Normal = -Normal;
+			}
+			TriangleNormalSum += TriangleNormals.Add_GetRef(Normal);
+		}
+		if (TriangleNormals.Num() == 2 && FVector::DotProduct(TriangleNormals[0], TriangleNormals[1]) >= TAUT_ROPE_SHAPE_COPLANAR_NORMAL_DOT)
+		{
+			continue;
 		}
 		const FVector Forward = (Vertices[Edges[EdgeIndex].Y] - Vertices[Edges[EdgeIndex].X]).GetSafeNormal();
 		const FVector Up = TriangleNormalSum.GetSafeNormal();
-		EdgeRotations[EdgeIndex] = FRotationMatrix::MakeFromXZ(Forward, Up).ToQuat();
+		FeatureEdges.Add(Edges[EdgeIndex]);
+		FeatureEdgeRotations.Add(FRotationMatrix::MakeFromXZ(Forward, Up).ToQuat());
+	}
+
+	// Vertices inside a flat face, like the center of an n-gon fan, are left without edges and dropped.
+	TArray<int32> FeatureVertIndices;
+	FeatureVertIndices.Init(INDEX_NONE, Vertices.Num());
+	TArray<FVector> FeatureVertices;
+	auto RemapVertIndex = [&](int32& VertIndex)
+		{
+			if (FeatureVertIndices[VertIndex] == INDEX_NONE)
+			{
+				FeatureVertIndices[VertIndex] = FeatureVertices.Add(Vertices[VertIndex]);
+			}
+			VertIndex = FeatureVertIndices[VertIndex];
+		};
+	for (FIntVector2& Edge : FeatureEdges)
+	{
+		RemapVertIndex(Edge.X);
+		RemapVertIndex(Edge.Y);
 	}
+	Vertices = MoveTemp(FeatureVertices);
+	Edges = MoveTemp(FeatureEdges);
+	EdgeRotations = MoveTemp(FeatureEdgeRotations);
+
+	PopulateVertToEdges();
 
 	IsCornerVertexList.Init(false, Vertices.Num());
 };
@@ -100,6 +148,204 @@ FTautRopeCollisionShape::FTautRopeCollisionShape(
 	}
 };
 
+FTautRopeCollisionShape::FTautRopeCollisionShape(
+	const TSharedRef<const FTautRopeCollisionShape>& InPrototype
+	, const FTransform& InTransform
+)
+	: bIsLocalSpace(true)
+	, Transform(InTransform)
+	, Prototype(InPrototype)
+	, PrevTransform(InTransform)
+	, TargetTransform(InTransform)
+{
+};
+
+FTautRopeCollisionShape::FTautRopeCollisionShape(
+	const FKConvexElem& Convex
+	, USceneComponent* InOwningComponent
+)
+	: FTautRopeCollisionShape(Convex, FTransform(FQuat::Identity, FVector::ZeroVector, InOwningComponent->GetComponentScale()))
+{
+	// Intermediate edges are skipped, the geometry they split against does not move along.
+	bIsLocalSpace = true;
+	OwningComponent = InOwningComponent;
+	Transform = FTransform(InOwningComponent->GetComponentQuat(), InOwningComponent->GetComponentLocation());
+	PrevTransform = Transform;
+	TargetTransform = Transform;
+};
+
+// The box's corners with outward wound triangles, in the component space of the box elem.
+static FKConvexElem MakeBoxConvex(const FKBoxElem& Box)
+{
+	FKConvexElem Convex;
+	const FTransform ElemTransform = Box.GetTransform();
+	for (int32 VertIndex = 0; VertIndex < 8; ++VertIndex)
+	{
+		Convex.VertexData.Add(ElemTransform.TransformPosition(FVector(
+			(VertIndex & 1) ? Box.X : -Box.X
+			, (VertIndex & 2) ? Box.Y : -Box.Y
+			, (VertIndex & 4) ? Box.Z : -Box.Z
+		) * 0.5));
+	}
+	const FVector Center = ElemTransform.GetLocation();
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		const int32 BitU = 1 << ((Axis + 1) % 3);
+		const int32 BitV = 1 << ((Axis + 2) % 3);
+		for (int32 Side = 0; Side < 2; ++Side)
+		{
+			const int32 Base = Side ? 1 << Axis : 0;
+			const int32 Face[4] = { Base, Base | BitU, Base | BitU | BitV, Base | BitV };
+			for (int32 Tri = 0; Tri < 2; ++Tri)
+			{
+				int32 VertB = Face[1 + Tri];
+				int32 VertC = Face[2 + Tri];
+				const FVector& A = Convex.VertexData[Face[0]];
+				const FVector Normal = FVector::CrossProduct(Convex.VertexData[VertB] - A, Convex.VertexData[VertC] - A);
+				if (FVector::DotProduct(Normal, A - Center) < 0.)
+				{
+					Swap(VertB, VertC);
+				}
+				Convex.IndexData.Append({ Face[0], VertB, VertC });
+			}
+		}
+	}
+	return Convex;
+}
+
+FTautRopeCollisionShape::FTautRopeCollisionShape(
+	const FKBoxElem& Box
+	, const FTransform& CompTransform
+)
+{
+	const FVector Scale = CompTransform.GetScale3D().GetAbs();
+	if (!Box.Rotation.IsNearlyZero() && !Scale.AllComponentsEqual(KINDA_SMALL_NUMBER))
+	{
+		// Scaling a rotated box unevenly along the component axes shears it, so it is baked as the convex of its corners.
+		*this = FTautRopeCollisionShape(MakeBoxConvex(Box), CompTransform);
+		return;
+	}
+	Type = ETautRopeCollisionShapeType::Box;
+	BoxExtent = FVector(Box.X, Box.Y, Box.Z) * 0.5f * Scale;
+	bIsLocalSpace = true;
+	const FTransform BoxTransform = Box.GetTransform() * CompTransform;
+	Transform = FTransform(BoxTransform.GetRotation(), BoxTransform.GetLocation());
+	PrevTransform = Transform;
+	TargetTransform = Transform;
+};
+
+FTautRopeCollisionShape::FTautRopeCollisionShape(
+	const FKBoxElem& Box
+	, USceneComponent* InOwningComponent
+)
+	: FTautRopeCollisionShape(Box, FTransform(FQuat::Identity, FVector::ZeroVector, InOwningComponent->GetComponentScale()))
+{
+	// Sheared boxes come back as convexes in the component's scaled frame, which follow it the same way.
+	bIsLocalSpace = true;
+	AttachToOwningComponent(InOwningComponent);
+};
+
+FTautRopeCollisionShape::FTautRopeCollisionShape(
+	const FKSphereElem& Sphere
+	, const FTransform& CompTransform
+)
+	: Type(ETautRopeCollisionShapeType::Sphere)
+	, Radius(Sphere.Radius * CompTransform.GetScale3D().GetAbsMax())
+	, bIsLocalSpace(true)
+{
+	const FTransform SphereTransform = Sphere.GetTransform() * CompTransform;
+	Transform = FTransform(SphereTransform.GetRotation(), SphereTransform.GetLocation());
+	PrevTransform = Transform;
+	TargetTransform = Transform;
+};
+
+FTautRopeCollisionShape::FTautRopeCollisionShape(
+	const FKSphereElem& Sphere
+	, USceneComponent* InOwningComponent
+)
+	: FTautRopeCollisionShape(Sphere, FTransform(FQuat::Identity, FVector::ZeroVector, InOwningComponent->GetComponentScale()))
+{
+	AttachToOwningComponent(InOwningComponent);
+};
+
+FTautRopeCollisionShape::FTautRopeCollisionShape(
+	const FKSphylElem& Capsule
+	, const FTransform& CompTransform
+)
+	: Type(ETautRopeCollisionShapeType::Capsule)
+	, Radius(Capsule.Radius * FMath::Max(FMath::Abs(CompTransform.GetScale3D().X), FMath::Abs(CompTransform.GetScale3D().Y)))
+	, HalfLength(Capsule.Length * 0.5f * FMath::Abs(CompTransform.GetScale3D().Z))
+	, bIsLocalSpace(true)
+{
+	const FTransform CapsuleTransform = Capsule.GetTransform() * CompTransform;
+	Transform = FTransform(CapsuleTransform.GetRotation(), CapsuleTransform.GetLocation());
+	PrevTransform = Transform;
+	TargetTransform = Transform;
+};
+
+FTautRopeCollisionShape::FTautRopeCollisionShape(
+	const FKSphylElem& Capsule
+	, USceneComponent* InOwningComponent
+)
+	: FTautRopeCollisionShape(Capsule, FTransform(FQuat::Identity, FVector::ZeroVector, InOwningComponent->GetComponentScale()))
+{
+	AttachToOwningComponent(InOwningComponent);
+};
+
+void FTautRopeCollisionShape::AttachToOwningComponent(USceneComponent* InOwningComponent)
+{
+	OwningComponent = InOwningComponent;
+	OwningComponentOffset = Transform;
+	Transform = OwningComponentOffset * FTransform(InOwningComponent->GetComponentQuat(), InOwningComponent->GetComponentLocation());
+	PrevTransform = Transform;
+	TargetTransform = Transform;
+}
+
+const FTautRopeCollisionShape& FTautRopeCollisionShape::GetBoxTopology()
+{
+	// Unit box corners, indexed by the sign bits of their axes, with edges running along each axis.
+	static const FTautRopeCollisionShape BoxTopology = []()
+		{
+			FTautRopeCollisionShape Topology;
+			for (int32 VertIndex = 0; VertIndex < 8; ++VertIndex)
+			{
+				Topology.Vertices.Add(FVector(
+					(VertIndex & 1) ? 1. : -1.
+					, (VertIndex & 2) ? 1. : -1.
+					, (VertIndex & 4) ? 1. : -1.
+				));
+			}
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				for (int32 VertIndex = 0; VertIndex < 8; ++VertIndex)
+				{
+					if (VertIndex & (1 << Axis))
+					{
+						continue;
+					}
+					Topology.Edges.Add(FIntVector2(VertIndex, VertIndex | (1 << Axis)));
+					FVector Forward = FVector::ZeroVector;
+					Forward[Axis] = 1.;
+					FVector Up = Topology.Vertices[VertIndex];
+					Up[Axis] = 0.;
+					Topology.EdgeRotations.Add(FRotationMatrix::MakeFromXZ(Forward, Up.GetSafeNormal()).ToQuat());
+				}
+			}
+			Topology.PopulateVertToEdges();
+			Topology.IsCornerVertexList.Init(false, Topology.Vertices.Num());
+			return Topology;
+		}();
+	return BoxTopology;
+}
+
+void FTautRopeCollisionShape::RefreshTargetTransform()
+{
+	if (const USceneComponent* Component = OwningComponent.Get())
+	{
+		TargetTransform = OwningComponentOffset * FTransform(Component->GetComponentQuat(), Component->GetComponentLocation());
+	}
+}
+
 void FTautRopeCollisionShape::MakeInitialHitResults(
 	FHitResult& InitHitResultA
 	, FHitResult& InitHitResultB
@@ -243,6 +489,397 @@ void FTautRopeCollisionShape::CreateIntermedateEdges(
 	CreateIntermedateEdges(NewHitResultB, LastHitResultB, EdgeRotation, OtherPrimComps, TraceParams);
 };
 
+void FTautRopeCollisionShape::BuildKernelEdges()
+{
+	KernelEdgeVertices.Reset();
+	if (IsCurved() || Prototype.IsValid())
+	{
+		return;
+	}
+	// Local space geometry is already small around its frame, world space geometry is centered on its bounds. Prototypes
+	// are baked in the space of their instances, so their kernel serves every instance.
+	KernelOrigin = bIsLocalSpace ? FVector::ZeroVector : CalcBounds().GetCenter();
+	const FTautRopeCollisionShape& Geometry = GetGeometry();
+	KernelEdgeVertices.Reserve(Geometry.Edges.Num() * 2);
+	for (const FIntVector2& Edge : Geometry.Edges)
+	{
+		KernelEdgeVertices.Add(FVector3f(GetLocalVertex(Edge.X) - KernelOrigin));
+		KernelEdgeVertices.Add(FVector3f(GetLocalVertex(Edge.Y) - KernelOrigin));
+	}
+}
+
+void FTautRopeCollisionShape::BuildEdgeBounds()
+{
+	EdgeBounds = FBox(ForceInit);
+	if (IsCurved() || Type == ETautRopeCollisionShapeType::Box)
+	{
+		return;
+	}
+	const FTautRopeCollisionShape& Geometry = GetGeometry();
+	for (int32 VertIndex = 0; VertIndex < Geometry.Vertices.Num(); ++VertIndex)
+	{
+		EdgeBounds += GetLocalVertex(VertIndex);
+	}
+}
+
+void FTautRopeCollisionShape::BuildEdgeGrid()
+{
+	EdgeBoxes.Reset();
+	EdgeGridCellStarts.Reset();
+	EdgeGridEdges.Reset();
+	if (IsCurved() || Prototype.IsValid())
+	{
+		return;
+	}
+	const FTautRopeCollisionShape& Geometry = GetGeometry();
+	FBox Bounds(ForceInit);
+	double EdgeLengthSum = 0.;
+	EdgeBoxes.Reserve(Geometry.Edges.Num());
+	for (const FIntVector2& Edge : Geometry.Edges)
+	{
+		const FVector VertA = GetLocalVertex(Edge.X);
+		const FVector VertB = GetLocalVertex(Edge.Y);
+		FBox& EdgeBox = EdgeBoxes.Add_GetRef(FBox(ForceInit));
+		EdgeBox += VertA;
+		EdgeBox += VertB;
+		Bounds += EdgeBox;
+		EdgeLengthSum += FVector::Dist(VertA, VertB);
+	}
+	if (Geometry.Edges.Num() < TAUT_ROPE_EDGE_GRID_MIN_EDGES)
+	{
+		return;
+	}
+	const FVector Size = Bounds.GetSize();
+	EdgeGridCellSize = FMath::Max3(EdgeLengthSum / Geometry.Edges.Num(), Size.GetMax() / TAUT_ROPE_EDGE_GRID_MAX_CELLS_PER_AXIS, double(TAUT_ROPE_DISTANCE_TOLERANCE));
+	EdgeGridOrigin = Bounds.Min;
+	EdgeGridDims = FIntVector(
+		FMath::Min(FMath::FloorToInt32(Size.X / EdgeGridCellSize) + 1, TAUT_ROPE_EDGE_GRID_MAX_CELLS_PER_AXIS)
+		, FMath::Min(FMath::FloorToInt32(Size.Y / EdgeGridCellSize) + 1, TAUT_ROPE_EDGE_GRID_MAX_CELLS_PER_AXIS)
+		, FMath::Min(FMath::FloorToInt32(Size.Z / EdgeGridCellSize) + 1, TAUT_ROPE_EDGE_GRID_MAX_CELLS_PER_AXIS)
+	);
+	auto ForEachCell = [this](const FBox& Box, auto&& Visit)
+		{
+			const FIntVector MinCell = GetEdgeGridCell(Box.Min);
+			const FIntVector MaxCell = GetEdgeGridCell(Box.Max);
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+			{
+				for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+				{
+					for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+					{
+						Visit((Z * EdgeGridDims.Y + Y) * EdgeGridDims.X + X);
+					}
+				}
+			}
+		};
+	// Counting sort of the edges into their cells.
+	EdgeGridCellStarts.SetNumZeroed(EdgeGridDims.X * EdgeGridDims.Y * EdgeGridDims.Z + 1);
+	for (const FBox& EdgeBox : EdgeBoxes)
+	{
+		ForEachCell(EdgeBox, [this](const int32 Cell) { ++EdgeGridCellStarts[Cell + 1]; });
+	}
+	for (int32 Cell = 1; Cell < EdgeGridCellStarts.Num(); ++Cell)
+	{
+		EdgeGridCellStarts[Cell] += EdgeGridCellStarts[Cell - 1];
+	}
+	TArray<int32> CellEnds(EdgeGridCellStarts.GetData(), EdgeGridCellStarts.Num() - 1);
+	EdgeGridEdges.SetNumUninitialized(EdgeGridCellStarts.Last());
+	for (int32 EdgeIndex = 0; EdgeIndex < EdgeBoxes.Num(); ++EdgeIndex)
+	{
+		ForEachCell(EdgeBoxes[EdgeIndex], [this, &CellEnds, EdgeIndex](const int32 Cell) { EdgeGridEdges[CellEnds[Cell]++] = EdgeIndex; });
+	}
+}
+
+FIntVector FTautRopeCollisionShape::GetEdgeGridCell(const FVector& LocalLocation) const
+{
+	const FVector Cell = (LocalLocation - EdgeGridOrigin) / EdgeGridCellSize;
+	return FIntVector(
+		FMath::Clamp(FMath::FloorToInt32(Cell.X), 0, EdgeGridDims.X - 1)
+		, FMath::Clamp(FMath::FloorToInt32(Cell.Y), 0, EdgeGridDims.Y - 1)
+		, FMath::Clamp(FMath::FloorToInt32(Cell.Z), 0, EdgeGridDims.Z - 1)
+	);
+}
+
+bool FTautRopeCollisionShape::IsAnyEdgeOverlapping(
+	const FBox& Box
+	, const TBitArray<>& IgnoredEdges
+) const
+{
+	const FTautRopeCollisionShape& Kernel = GetKernelShape();
+	auto IsOverlapping = [&Kernel, &Box, &IgnoredEdges](const int32 EdgeIndex)
+		{
+			return !IgnoredEdges[EdgeIndex] && Kernel.EdgeBoxes[EdgeIndex].Intersect(Box);
+		};
+	if (Kernel.EdgeGridCellStarts.IsEmpty())
+	{
+		for (int32 EdgeIndex = 0; EdgeIndex < Kernel.EdgeBoxes.Num(); ++EdgeIndex)
+		{
+			if (IsOverlapping(EdgeIndex))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+	// Edges spanning several cells are tested once per cell, which is cheaper than tracking the visited ones.
+	const FIntVector MinCell = Kernel.GetEdgeGridCell(Box.Min);
+	const FIntVector MaxCell = Kernel.GetEdgeGridCell(Box.Max);
+	for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+			{
+				const int32 Cell = (Z * Kernel.EdgeGridDims.Y + Y) * Kernel.EdgeGridDims.X + X;
+				for (int32 i = Kernel.EdgeGridCellStarts[Cell]; i < Kernel.EdgeGridCellStarts[Cell + 1]; ++i)
+				{
+					if (IsOverlapping(Kernel.EdgeGridEdges[i]))
+					{
+						return true;
+					}
+				}
+			}
+		}
+	}
+	return false;
+}
+
+uint32 FTautRopeCollisionShape::CalcSignature() const
+{
+	// Locations are rounded to whole units so the signature survives float noise from rebaking.
+	auto HashRounded = [](const uint32 Hash, const FVector& Location)
+		{
+			return HashCombineFast(Hash, GetTypeHash(FIntVector(FMath::RoundToInt32(Location.X), FMath::RoundToInt32(Location.Y), FMath::RoundToInt32(Location.Z))));
+		};
+
+	uint32 Signature = GetTypeHash(Type);
+	Signature = HashCombineFast(Signature, GetTypeHash(bIsLocalSpace));
+	if (const USceneComponent* Component = OwningComponent.Get())
+	{
+		// Shapes following a component are placed by where they sit on it, their world pose differs from machine to machine.
+		// The path within the level holds the owning actor, which tells placed copies of the same Blueprint apart.
+		Signature = HashCombineFast(Signature, FCrc::StrCrc32(*Component->GetPathName(Component->GetTypedOuter<ULevel>())));
+		Signature = HashRounded(Signature, OwningComponentOffset.GetLocation());
+	}
+	else if (bIsLocalSpace)
+	{
+		Signature = HashRounded(Signature, Transform.GetLocation());
+	}
+	if (IsCurved())
+	{
+		Signature = HashCombineFast(Signature, GetTypeHash(FMath::RoundToInt32(Radius)));
+		return HashCombineFast(Signature, GetTypeHash(FMath::RoundToInt32(HalfLength)));
+	}
+	const FTautRopeCollisionShape& Geometry = GetGeometry();
+	Signature = HashCombineFast(Signature, GetTypeHash(Geometry.Edges.Num()));
+	for (int32 VertIndex = 0; VertIndex < Geometry.Vertices.Num(); ++VertIndex)
+	{
+		Signature = HashRounded(Signature, GetLocalVertex(VertIndex));
+	}
+	return Signature;
+}
+
+void FTautRopeCollisionShape::AppendTriangleMeshShapes(
+	TConstArrayView<FVector3f> MeshVertices
+	, TConstArrayView<FIntVector> MeshTriangles
+	, const FTransform& CompTransform
+	, TArray<FTautRopeCollisionShape>& OutShapes
+)
+{
+	// Mesh vertices are split along UV and normal seams, so they are welded on a grid before looking for neighbors.
+	TArray<FVector> Vertices;
+	TArray<int32> WeldedVertIndices;
+	WeldedVertIndices.Reserve(MeshVertices.Num());
+	TMap<FIntVector, int32> WeldedVertIndexByCell;
+	for (const FVector3f& MeshVertex : MeshVertices)
+	{
+		const FVector Vertex = CompTransform.TransformPosition(FVector(MeshVertex));
+		const FIntVector Cell(
+			FMath::RoundToInt32(Vertex.X / TAUT_ROPE_SHAPE_MERGE_VERTEX_THRESHOLD)
+			, FMath::RoundToInt32(Vertex.Y / TAUT_ROPE_SHAPE_MERGE_VERTEX_THRESHOLD)
+			, FMath::RoundToInt32(Vertex.Z / TAUT_ROPE_SHAPE_MERGE_VERTEX_THRESHOLD)
+		);
+		const int32* WeldedVertIndex = WeldedVertIndexByCell.Find(Cell);
+		WeldedVertIndices.Add(WeldedVertIndex != nullptr ? *WeldedVertIndex : WeldedVertIndexByCell.Add(Cell, Vertices.Add(Vertex)));
+	}
+
+	struct FMeshEdge
+	{
+		int32 Triangles[2] = { INDEX_NONE, INDEX_NONE };
+		int32 NumTriangles = 0;
+	};
+	TArray<FIntVector> Triangles;
+	TArray<FVector> TriangleNormals;
+	// Keyed by both vertex indices, the lower one in the high bits.
+	TMap<uint64, FMeshEdge> MeshEdges;
+	for (const FIntVector& MeshTriangle : MeshTriangles)
+	{
+		const FIntVector Tri(WeldedVertIndices[MeshTriangle.X], WeldedVertIndices[MeshTriangle.Y], WeldedVertIndices[MeshTriangle.Z]);
+		if (Tri.X == Tri.Y || Tri.Y == Tri.Z || Tri.Z == Tri.X)
+		{
+			continue;
+		}
+		const FVector TriCross = FVector::CrossProduct(Vertices[Tri.Y] - Vertices[Tri.X], Vertices[Tri.Z] - Vertices[Tri.X]);
+		if (TriCross.Size() * 0.5f < KINDA_SMALL_NUMBER)
+		{
+			continue;
+		}
+		const int32 TriIndex = Triangles.Add(Tri);
+		TriangleNormals.Add(TriCross.GetSafeNormal());
+		for (int32 Corner = 0; Corner < 3; ++Corner)
+		{
+			const int32 VertA = FMath::Min(Tri[Corner], Tri[(Corner + 1) % 3]);
+			const int32 VertB = FMath::Max(Tri[Corner], Tri[(Corner + 1) % 3]);
+			FMeshEdge& MeshEdge = MeshEdges.FindOrAdd((static_cast<uint64>(VertA) << 32) | static_cast<uint32>(VertB));
+			if (MeshEdge.NumTriangles < 2)
+			{
+				MeshEdge.Triangles[MeshEdge.NumTriangles] = TriIndex;
+			}
+			MeshEdge.NumTriangles++;
+		}
+	}
+
+	const int32 FirstShapeIndex = OutShapes.Num();
+	TMap<FIntVector, int32> ShapeIndexByCell;
+	// Per new shape, from welded vertex index to the shape's own.
+	TArray<TMap<int32, int32>> ShapeVertIndices;
+	for (const TPair<uint64, FMeshEdge>& MeshEdgePair : MeshEdges)
+	{
+		const int32 VertA = static_cast<int32>(MeshEdgePair.Key >> 32);
+		const int32 VertB = static_cast<int32>(MeshEdgePair.Key & MAX_uint32);
+		const FMeshEdge& MeshEdge = MeshEdgePair.Value;
+		FVector Up;
+		if (MeshEdge.NumTriangles == 1)
+		{
+			// Open borders, like the top of a single sided wall, can be wrapped. The rope comes over them from either side
+			// of the face, so they point out of the face along it, away from the triangle's third vertex.
+			const FIntVector& Tri = Triangles[MeshEdge.Triangles[0]];
+			const int32 ThirdVert = Tri.X + Tri.Y + Tri.Z - VertA - VertB;
+			Up = FVector::CrossProduct(Vertices[VertB] - Vertices[VertA], TriangleNormals[MeshEdge.Triangles[0]]).GetSafeNormal();
+			if (FVector::DotProduct(Up, Vertices[ThirdVert] - Vertices[VertA]) > 0.)
+			{
+				Up = -Up;
+			}
+		}
+		else if (MeshEdge.NumTriangles == 2)
+		{
+			const FVector& NormalA = TriangleNormals[MeshEdge.Triangles[0]];
+			const FVector& NormalB = TriangleNormals[MeshEdge.Triangles[1]];
+			if (FVector::DotProduct(NormalA, NormalB) >= TAUT_ROPE_SHAPE_COPLANAR_NORMAL_DOT)
+			{
+				continue;
+			}
+			// Convex where the far corner of the other triangle lies behind the first one.
+			const FIntVector& TriB = Triangles[MeshEdge.Triangles[1]];
+			const int32 FarVertB = TriB.X + TriB.Y + TriB.Z - VertA - VertB;
+			if (FVector::DotProduct(NormalA, Vertices[FarVertB] - Vertices[VertA]) >= 0.)
+			{
+				continue;
+			}
+			Up = (NormalA + NormalB).GetSafeNormal();
+		}
+		else
+		{
+			// Non manifold edges have no single side to wrap.
+			continue;
+		}
+
+		const FVector& A = Vertices[VertA];
+		const FVector& B = Vertices[VertB];
+		const FVector Middle = (A + B) * 0.5;
+		const FIntVector Cell(
+			FMath::FloorToInt32(Middle.X / TAUT_ROPE_MESH_EDGE_CELL_SIZE)
+			, FMath::FloorToInt32(Middle.Y / TAUT_ROPE_MESH_EDGE_CELL_SIZE)
+			, FMath::FloorToInt32(Middle.Z / TAUT_ROPE_MESH_EDGE_CELL_SIZE)
+		);
+		int32* ShapeIndex = ShapeIndexByCell.Find(Cell);
+		if (ShapeIndex == nullptr)
+		{
+			ShapeIndex = &ShapeIndexByCell.Add(Cell, OutShapes.AddDefaulted());
+			ShapeVertIndices.AddDefaulted();
+		}
+		FTautRopeCollisionShape& Shape = OutShapes[*ShapeIndex];
+		TMap<int32, int32>& VertIndices = ShapeVertIndices[*ShapeIndex - FirstShapeIndex];
+		auto FindOrAddShapeVertex = [&Shape, &VertIndices, &Vertices](const int32 VertIndex)
+			{
+				if (const int32* ShapeVertIndex = VertIndices.Find(VertIndex))
+				{
+					return *ShapeVertIndex;
+				}
+				return VertIndices.Add(VertIndex, Shape.Vertices.Add(Vertices[VertIndex]));
+			};
+		Shape.Edges.Add(FIntVector2(FindOrAddShapeVertex(VertA), FindOrAddShapeVertex(VertB)));
+		Shape.EdgeRotations.Add(FRotationMatrix::MakeFromXZ((B - A).GetSafeNormal(), Up).ToQuat());
+	}
+
+	for (int32 ShapeIndex = FirstShapeIndex; ShapeIndex < OutShapes.Num(); ++ShapeIndex)
+	{
+		FTautRopeCollisionShape& Shape = OutShapes[ShapeIndex];
+		Shape.PopulateVertToEdges();
+		// Where a ridge fades into a flat or concave region its last vertex has a single edge.
+		Shape.IsCornerVertexList.Init(false, Shape.Vertices.Num());
+		for (int32 VertexIndex = 0; VertexIndex < Shape.Vertices.Num(); ++VertexIndex)
+		{
+			Shape.IsCornerVertexList[VertexIndex] = Shape.VertToEdges[VertexIndex].Edges.Num() < 2;
+		}
+	}
+}
+
+FBox FTautRopeCollisionShape::CalcBounds() const
+{
+	FBox GeometryBounds(ForceInit);
+	switch (Type)
+	{
+		case ETautRopeCollisionShapeType::Box:
+		{
+			GeometryBounds = FBox(-BoxExtent, BoxExtent);
+			break;
+		}
+		case ETautRopeCollisionShapeType::Sphere:
+		case ETautRopeCollisionShapeType::Capsule:
+		{
+			const FVector CurvedExtent(Radius, Radius, Radius + HalfLength);
+			GeometryBounds = FBox(-CurvedExtent, CurvedExtent);
+			break;
+		}
+		default:
+		{
+			GeometryBounds = FBox(GetGeometry().Vertices);
+			break;
+		}
+	}
+	return bIsLocalSpace ? GeometryBounds.TransformBy(Transform) : GeometryBounds;
+}
+
+FArchive& operator<<(FArchive& Ar, FTautRopeCollisionShape& Shape)
+{
+	if (Ar.IsSaving() && Shape.Prototype.IsValid())
+	{
+		// Recordings are self contained, so instances are written with a copy of their prototype's geometry.
+		FTautRopeCollisionShape Flattened = *Shape.Prototype;
+		Flattened.bIsLocalSpace = Shape.bIsLocalSpace;
+		Flattened.Transform = Shape.Transform;
+		return Ar << Flattened;
+	}
+	Ar << Shape.Vertices;
+	Ar << Shape.Edges;
+	Ar << Shape.VertToEdges;
+	Ar << Shape.EdgeRotations;
+	Ar << Shape.IsCornerVertexList;
+	Ar << Shape.Type;
+	Ar << Shape.BoxExtent;
+	Ar << Shape.Radius;
+	Ar << Shape.HalfLength;
+	Ar << Shape.bIsLocalSpace;
+	Ar << Shape.Transform;
+	if (Ar.IsLoading())
+	{
+		Shape.PrevTransform = Shape.Transform;
+		Shape.TargetTransform = Shape.Transform;
+	}
+	return Ar;
+}
+
 void FTautRopeCollisionShape::PopulateVertToEdges()
 {
 	VertToEdges.Reset(Vertices.Num());
@@ -304,11 +941,24 @@ int32 FTautRopeCollisionShape::AddUniqueTriangle(int32 V1, int32 V2, int32 V3, T
 #if TAUT_ROPE_DEBUG_DRAWING
 void FTautRopeCollisionShape::DrawDebug(const UWorld* World) const
 {
-	for (int32 EdgeIndex = 0; EdgeIndex < Edges.Num(); ++EdgeIndex)
+	if (IsCurved())
 	{
-		const FIntVector2& Edge = Edges[EdgeIndex];
-		const FVector EdgeVertA = Vertices[Edge.X];
-		const FVector EdgeVertB = Vertices[Edge.Y];
+		DrawDebugCapsule(
+			World
+			, Transform.GetLocation()
+			, HalfLength + Radius
+			, Radius
+			, Transform.GetRotation()
+			, FColor::Blue
+		);
+		return;
+	}
+	const FTautRopeCollisionShape& Geometry = GetGeometry();
+	for (int32 EdgeIndex = 0; EdgeIndex < Geometry.Edges.Num(); ++EdgeIndex)
+	{
+		const FIntVector2& Edge = Geometry.Edges[EdgeIndex];
+		const FVector EdgeVertA = GetVertex(Edge.X);
+		const FVector EdgeVertB = GetVertex(Edge.Y);
 		DrawDebugLine(
 			World
 			, EdgeVertA
@@ -320,15 +970,15 @@ void FTautRopeCollisionShape::DrawDebug(const UWorld* World) const
 		DrawDebugLine(
 			World
 			, Center
-			, Center + EdgeRotations[EdgeIndex].GetUpVector() * FVector::Dist(EdgeVertA, EdgeVertB) * 0.05f
+			, Center + GetEdgeRotation(EdgeIndex).GetUpVector() * FVector::Dist(EdgeVertA, EdgeVertB) * 0.05f
 			, FColor::Yellow
 		);
 	}
-	for (int32 VertIndex = 0; VertIndex < Vertices.Num(); ++VertIndex)
+	for (int32 VertIndex = 0; VertIndex < Geometry.Vertices.Num(); ++VertIndex)
 	{
 		DrawDebugSphere(
 			World
-			, Vertices[VertIndex]
+			, GetVertex(VertIndex)
 			, 0.5f
 			, 4
 			, IsCornerVertex(VertIndex) ? FColor::Red : FColor::Yellow
@@ -3,8 +3,14 @@
 
 #include "TautRopeCollisionVolumeActor.h"
 
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Interface_CollisionDataProviderCore.h"
+#include "Misc/ScopeExit.h"
 #include "PhysicsEngine/BodySetup.h"
+#include "PhysicsEngine/BoxElem.h"
 #include "PhysicsEngine/ConvexElem.h"
+#include "PhysicsEngine/SphereElem.h"
+#include "PhysicsEngine/SphylElem.h"
 
 
 #if TAUT_ROPE_DEBUG_DRAWING
@@ -32,6 +38,14 @@ ATautRopeCollisionVolumeActor::ATautRopeCollisionVolumeActor()
 #endif // TAUT_ROPE_DEBUG_DRAWING
 }
 
+void ATautRopeCollisionVolumeActor::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	// Before any BeginPlay, so ropes can gather the instance shapes from theirs.
+	BuildInstanceShapes();
+}
+
 // Called when the game starts or when spawned
 void ATautRopeCollisionVolumeActor::BeginPlay()
 {
@@ -85,13 +99,51 @@ void ATautRopeCollisionVolumeActor::Tick(float DeltaTime)
 	{
 		Shape.DrawDebug(World);
 	}
+	for (const FTautRopeCollisionShape& Shape : MovableShapes)
+	{
+		Shape.DrawDebug(World);
+	}
+	for (const FTautRopeCollisionShape& Shape : InstanceShapes)
+	{
+		Shape.DrawDebug(World);
+	}
 }
 #endif // TAUT_ROPE_DEBUG_DRAWING
 
+void ATautRopeCollisionVolumeActor::BuildInstanceShapes()
+{
+	TArray<TSharedRef<const FTautRopeCollisionShape>> SharedPrototypes;
+	SharedPrototypes.Reserve(ShapePrototypes.Num());
+	for (const FTautRopeCollisionShape& ShapePrototype : ShapePrototypes)
+	{
+		const TSharedRef<FTautRopeCollisionShape> SharedPrototype = MakeShared<FTautRopeCollisionShape>(ShapePrototype);
+#if TAUT_ROPE_FLOAT_SWEEP_KERNEL
+		SharedPrototype->BuildKernelEdges();
+#endif
+		SharedPrototype->BuildEdgeGrid();
+		SharedPrototypes.Add(SharedPrototype);
+	}
+	InstanceShapes.Reset(ShapeInstances.Num());
+	for (const FTautRopeCollisionShapeInstance& ShapeInstance : ShapeInstances)
+	{
+		if (SharedPrototypes.IsValidIndex(ShapeInstance.PrototypeIndex))
+		{
+			InstanceShapes.Emplace(SharedPrototypes[ShapeInstance.PrototypeIndex], ShapeInstance.Transform);
+		}
+	}
+}
+
 #if WITH_EDITOR
 void ATautRopeCollisionVolumeActor::PopulateStaticShapes()
 {
 	StaticShapes.Empty();
+	MovableShapes.Empty();
+	ShapePrototypes.Empty();
+	ShapeInstances.Empty();
+	ON_SCOPE_EXIT
+	{
+		BuildInstanceShapes();
+	};
 
 	const UWorld* World = GetWorld();
 	if (!IsValid(World))
@@ -109,12 +161,16 @@ void ATautRopeCollisionVolumeActor::PopulateStaticShapes()
 	const FVector BoxExtent = CollisionVolume->GetScaledBoxExtent();
 	const FQuat BoxRotation = CollisionVolume->GetComponentQuat();
 
+	// Movable geometry such as doors and lifts usually has the WorldDynamic object type, so it is queried for MovableShapes.
+	FCollisionObjectQueryParams ObjectQueryParams(ECC_WorldStatic);
+	ObjectQueryParams.AddObjectTypesToQuery(ECC_WorldDynamic);
+
 	TArray<FOverlapResult> Overlaps;
 	GetWorld()->OverlapMultiByObjectType(
 		Overlaps,
 		BoxCenter,
 		BoxRotation, // Use the component's rotation
-		FCollisionObjectQueryParams(ECC_WorldStatic),
+		ObjectQueryParams,
 		FCollisionShape::MakeBox(BoxExtent)
 	);
 	if (Overlaps.IsEmpty())
@@ -122,18 +178,121 @@ void ATautRopeCollisionVolumeActor::PopulateStaticShapes()
 		return;
 	}
 
+	// Static shapes are only split against other static geometry, since movable geometry does not stay put.
 	TArray<UPrimitiveComponent*> PrimComponents;
+	TArray<UPrimitiveComponent*> MovablePrimComponents;
+	TMap<const UInstancedStaticMeshComponent*, TArray<int32>> InstanceIndicesByComponent;
 	PrimComponents.Reserve(Overlaps.Num());
 	for (const FOverlapResult& Result : Overlaps)
 	{
 		UPrimitiveComponent* PrimComp = Result.Component.Get();
-		if (IsValid(PrimComp))
+		if (!IsValid(PrimComp))
+		{
+			continue;
+		}
+		// Instanced components overlap once per instance.
+		if (const UInstancedStaticMeshComponent* InstancedComp = Cast<UInstancedStaticMeshComponent>(PrimComp))
+		{
+			InstanceIndicesByComponent.FindOrAdd(InstancedComp).AddUnique(Result.ItemIndex);
+			PrimComponents.AddUnique(PrimComp);
+		}
+		else if (PrimComp->Mobility == EComponentMobility::Movable)
+		{
+			MovablePrimComponents.Add(PrimComp);
+		}
+		else if (PrimComp->GetCollisionObjectType() == ECC_WorldDynamic)
+		{
+			// Static baking keeps to WorldStatic geometry as it did before movable shapes were queried.
+			continue;
+		}
+		else
 		{
 			PrimComponents.Add(PrimComp);
 		}
 	}
+	for (UPrimitiveComponent* PrimComp : MovablePrimComponents)
+	{
+		const UBodySetup* BodySetup = PrimComp->GetBodySetup();
+		if (!IsValid(BodySetup))
+		{
+			continue;
+		}
+		for (const FKConvexElem& Convex : BodySetup->AggGeom.ConvexElems)
+		{
+			MovableShapes.Add(FTautRopeCollisionShape(Convex, PrimComp));
+		}
+		for (const FKBoxElem& Box : BodySetup->AggGeom.BoxElems)
+		{
+			MovableShapes.Add(FTautRopeCollisionShape(Box, PrimComp));
+		}
+		for (const FKSphereElem& Sphere : BodySetup->AggGeom.SphereElems)
+		{
+			MovableShapes.Add(FTautRopeCollisionShape(Sphere, PrimComp));
+		}
+		for (const FKSphylElem& Capsule : BodySetup->AggGeom.SphylElems)
+		{
+			MovableShapes.Add(FTautRopeCollisionShape(Capsule, PrimComp));
+		}
+	}
+
+	// Instances are not split against neighboring geometry, so every instance of a mesh at a given scale shares one baked prototype.
+	constexpr float PrototypeScaleSnap = 0.001f;
+	TMap<TTuple<const UStaticMesh*, FVector>, TArray<int32>> PrototypeIndicesByMeshAndScale;
+	for (const TPair<const UInstancedStaticMeshComponent*, TArray<int32>>& InstancedComponent : InstanceIndicesByComponent)
+	{
+		const UInstancedStaticMeshComponent* InstancedComp = InstancedComponent.Key;
+		const UStaticMesh* StaticMesh = InstancedComp->GetStaticMesh();
+		if (!IsValid(StaticMesh) || !IsValid(StaticMesh->GetBodySetup()))
+		{
+			continue;
+		}
+		for (const int32 InstanceIndex : InstancedComponent.Value)
+		{
+			FTransform InstanceTransform;
+			if (!InstancedComp->GetInstanceTransform(InstanceIndex, InstanceTransform, true))
+			{
+				continue;
+			}
+			const FVector Scale = InstanceTransform.GetScale3D().GridSnap(PrototypeScaleSnap);
+			TArray<int32>* PrototypeIndices = PrototypeIndicesByMeshAndScale.Find(MakeTuple(StaticMesh, Scale));
+			if (PrototypeIndices == nullptr)
+			{
+				PrototypeIndices = &PrototypeIndicesByMeshAndScale.Add(MakeTuple(StaticMesh, Scale));
+				const FTransform ScaleTransform(FQuat::Identity, FVector::ZeroVector, Scale);
+				for (const FKConvexElem& Convex : StaticMesh->GetBodySetup()->AggGeom.ConvexElems)
+				{
+					PrototypeIndices->Add(ShapePrototypes.Add(FTautRopeCollisionShape(Convex, ScaleTransform)));
+				}
+			}
+			const FTransform InstancePose(InstanceTransform.GetRotation(), InstanceTransform.GetLocation());
+			// Boxes and curved shapes are already just a few parameters, so they are placed directly rather than shared.
+			for (const FKBoxElem& Box : StaticMesh->GetBodySetup()->AggGeom.BoxElems)
+			{
+				StaticShapes.Add(FTautRopeCollisionShape(Box, InstanceTransform));
+			}
+			for (const FKSphereElem& Sphere : StaticMesh->GetBodySetup()->AggGeom.SphereElems)
+			{
+				StaticShapes.Add(FTautRopeCollisionShape(Sphere, InstanceTransform));
+			}
+			for (const FKSphylElem& Capsule : StaticMesh->GetBodySetup()->AggGeom.SphylElems)
+			{
+				StaticShapes.Add(FTautRopeCollisionShape(Capsule, InstanceTransform));
+			}
+			for (const int32 PrototypeIndex : *PrototypeIndices)
+			{
+				FTautRopeCollisionShapeInstance& ShapeInstance = ShapeInstances.AddDefaulted_GetRef();
+				ShapeInstance.PrototypeIndex = PrototypeIndex;
+				ShapeInstance.Transform = InstancePose;
+			}
+		}
+	}
+
 	for (UPrimitiveComponent* PrimComp : PrimComponents)
 	{
+		if (PrimComp->IsA<UInstancedStaticMeshComponent>())
+		{
+			continue;
+		}
 		const UBodySetup* BodySetup = nullptr;
 		const UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(PrimComp);
 		if (IsValid(StaticMeshComponent))
@@ -153,6 +312,22 @@ void ATautRopeCollisionVolumeActor::PopulateStaticShapes()
 		{
 			continue;
 		}
+		if (bBakeComplexCollision && IsValid(StaticMeshComponent) && BodySetup->GetCollisionTraceFlag() == CTF_UseComplexAsSimple)
+		{
+			// The simple shapes are not used for collision, the triangles are.
+			FTriMeshCollisionData TriMeshData;
+			if (StaticMeshComponent->GetStaticMesh()->GetPhysicsTriMeshData(&TriMeshData, false))
+			{
+				TArray<FIntVector> MeshTriangles;
+				MeshTriangles.Reserve(TriMeshData.Indices.Num());
+				for (const FTriIndices& TriIndices : TriMeshData.Indices)
+				{
+					MeshTriangles.Add(FIntVector(TriIndices.v0, TriIndices.v1, TriIndices.v2));
+				}
+				FTautRopeCollisionShape::AppendTriangleMeshShapes(TriMeshData.Vertices, MeshTriangles, PrimComp->GetComponentTransform(), StaticShapes);
+			}
+			continue;
+		}
 		TArray<UPrimitiveComponent*> OtherPrimComponents = TArray(PrimComponents);
 		OtherPrimComponents.Remove(PrimComp);
 		for (const FKConvexElem& Convex : BodySetup->AggGeom.ConvexElems)
@@ -160,6 +335,19 @@ void ATautRopeCollisionVolumeActor::PopulateStaticShapes()
 			FTautRopeCollisionShape Shape = FTautRopeCollisionShape(Convex, PrimComp, OtherPrimComponents);
 			StaticShapes.Add(MoveTemp(Shape));
 		}
+		// Boxes keep their 12 edges, they are not split against neighboring geometry.
+		for (const FKBoxElem& Box : BodySetup->AggGeom.BoxElems)
+		{
+			StaticShapes.Add(FTautRopeCollisionShape(Box, PrimComp->GetComponentTransform()));
+		}
+		for (const FKSphereElem& Sphere : BodySetup->AggGeom.SphereElems)
+		{
+			StaticShapes.Add(FTautRopeCollisionShape(Sphere, PrimComp->GetComponentTransform()));
+		}
+		for (const FKSphylElem& Capsule : BodySetup->AggGeom.SphylElems)
+		{
+			StaticShapes.Add(FTautRopeCollisionShape(Capsule, PrimComp->GetComponentTransform()));
+		}
 	}
 }
 #endif // WITH_EDITOR
\ No newline at end of file
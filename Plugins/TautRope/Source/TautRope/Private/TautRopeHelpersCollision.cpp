@@ -1,8 +1,11 @@
 ﻿
 #include "TautRopeHelpersCollision.h"
 #include "TautRopeConfig.h"
+#include "TautRopeHelpersCurved.h"
 #include "TautRopePoint.h"
 
+#include "Algo/Reverse.h"
+
 namespace TautRope
 {
 	void SweepRemovePoint
@@ -85,8 +88,274 @@ namespace TautRope
 		}
 	}
 
+	void SweepRemovePoints(
+		TArray<FPoint>& RopePoints
+		, const int32 FirstRemovePointIndex
+		, const int32 LastRemovePointIndex
+		, const TArray<FTautRopeCollisionShape>& Shapes
+		, const TArray<FBox>& ShapeBounds
+#if TAUT_ROPE_DEBUG_DRAWING
+		, const UWorld* World
+		, const bool bIsDebugDrawingActive
+#endif
+	)
+	{
+		ensure(FirstRemovePointIndex > 0 && FirstRemovePointIndex <= LastRemovePointIndex && LastRemovePointIndex < RopePoints.Num() - 1);
+
+		// Removing the run back to front sweeps each point onto the point after the run, which makes the swept area a fan.
+		const int32 SupportPointIndex = LastRemovePointIndex + 1;
+		const FVector SupportLocation = RopePoints[SupportPointIndex].Location;
+		FBox FanBounds(ForceInit);
+		for (int32 i = FirstRemovePointIndex - 1; i <= SupportPointIndex; ++i)
+		{
+			FanBounds += RopePoints[i].Location;
+		}
+
+		// The last point of the run whose fan triangle hits a shape. Points behind it clear in one go.
+		int32 HitRemovePointIndex = FirstRemovePointIndex - 1;
+		TArray<FIntVector2> IgnoredEdges;
+		for (int32 ShapeIndex = 0; ShapeIndex < Shapes.Num(); ++ShapeIndex)
+		{
+			if (!ShapeBounds[ShapeIndex].Intersect(FanBounds))
+			{
+				continue;
+			}
+			for (int32 i = LastRemovePointIndex; i > HitRemovePointIndex; --i)
+			{
+				IgnoredEdges = {
+					FIntVector2(RopePoints[i - 1].ShapeIndex, RopePoints[i - 1].EdgeIndex)
+					, FIntVector2(RopePoints[i].ShapeIndex, RopePoints[i].EdgeIndex)
+					, FIntVector2(RopePoints[SupportPointIndex].ShapeIndex, RopePoints[SupportPointIndex].EdgeIndex)
+				};
+				FHitData HitData;
+				SweepRemoveTriangleAgainstShape(
+					RopePoints[i].Location
+					, RopePoints[i - 1].Location
+					, SupportLocation
+					, Shapes[ShapeIndex]
+					, ShapeIndex
+					, IgnoredEdges
+					, HitData
+				);
+				if (HitData.bIsHit)
+				{
+					HitRemovePointIndex = i;
+					break;
+				}
+			}
+		}
+#if TAUT_ROPE_DEBUG_DRAWING
+		if (IsValid(World) && bIsDebugDrawingActive)
+		{
+			for (int32 i = LastRemovePointIndex; i > HitRemovePointIndex; --i)
+			{
+				DebugDrawSweep(World, RopePoints[i].Location, RopePoints[i - 1].Location, SupportLocation, false);
+			}
+		}
+#endif
+		RopePoints.RemoveAt(HitRemovePointIndex + 1, LastRemovePointIndex - HitRemovePointIndex);
+
+		// From the hit on, contacts get inserted and the fan no longer holds, so the rest is removed point by point.
+		for (int32 i = HitRemovePointIndex; i >= FirstRemovePointIndex; --i)
+		{
+			SweepRemovePoint(
+				RopePoints
+				, i
+				, Shapes
+#if TAUT_ROPE_DEBUG_DRAWING
+				, World
+				, bIsDebugDrawingActive
+#endif
+			);
+		}
+	}
+
+	// Where the ray from RayOrigin through RayTarget crosses the sweep edge from FromCorner to ToCorner.
+	static bool GetSweepEdgeCrossing(
+		const FVector& RayOrigin
+		, const FVector& RayTarget
+		, const FVector& FromCorner
+		, const FVector& ToCorner
+		, FVector& OutCrossing
+	)
+	{
+		const FVector RayDir = (RayTarget - RayOrigin).GetSafeNormal();
+		const FVector LineDir = ToCorner - FromCorner;
+		const FVector CrossDir = FVector::CrossProduct(LineDir, RayDir);
+		const double Denom = CrossDir.SizeSquared();
+		if (Denom <= KINDA_SMALL_NUMBER)
+		{
+			return false;
+		}
+		const double T = FVector::DotProduct(FVector::CrossProduct(RayOrigin - FromCorner, RayDir), CrossDir) / Denom;
+		if (T < 0. || T > 1.)
+		{
+			return false;
+		}
+		OutCrossing = FromCorner + LineDir * T;
+		return true;
+	}
+
+	// Follows the earliest hit with the other hits the rope sweeps into once bent around it. Each next hit has to lie in
+	// what is left of the swept triangle, between the stopped corner, the target corner and the last contact.
+	// Returns where the moving corner stops. The chain runs outward from the support corner.
+	static FVector BuildHitChain(
+		const FHitData& FirstHit
+		, const TArray<FHitData>& Candidates
+		, const FVector& ToCorner
+		, const int32 MaxChainHits
+		, TArray<FHitData>& OutHitChain
+	)
+	{
+		OutHitChain.Add(FirstHit);
+		// Only hits on world space edges lie in the plane of the swept triangle, so only those chain.
+		const bool bIsFirstHitChainable = Candidates.ContainsByPredicate([&FirstHit](const FHitData& Candidate)
+			{
+				return Candidate.ShapeIndex == FirstHit.ShapeIndex && Candidate.EdgeIndex == FirstHit.EdgeIndex;
+			});
+		FVector StopCorner = FirstHit.OnSweepEdgeLocation;
+		if (!bIsFirstHitChainable)
+		{
+			return StopCorner;
+		}
+		TBitArray<> IsUsed(false, Candidates.Num());
+		while (OutHitChain.Num() < MaxChainHits)
+		{
+			const FHitData& LastHit = OutHitChain.Last();
+			if (FVector::CrossProduct(ToCorner - StopCorner, LastHit.Location - StopCorner).SizeSquared() <= KINDA_SMALL_NUMBER)
+			{
+				break;
+			}
+			int32 NextIndex = INDEX_NONE;
+			FVector NextStopCorner = StopCorner;
+			double NextStopDistanceSquared = MAX_dbl;
+			for (int32 CandidateIndex = 0; CandidateIndex < Candidates.Num(); ++CandidateIndex)
+			{
+				const FHitData& Candidate = Candidates[CandidateIndex];
+				if (IsUsed[CandidateIndex] || (Candidate.ShapeIndex == LastHit.ShapeIndex && Candidate.EdgeIndex == LastHit.EdgeIndex))
+				{
+					continue;
+				}
+				// Edges through the last contact's vertices touch the remaining triangle only at its corner.
+				const FVector Barycentric = FMath::ComputeBaryCentric2D(Candidate.Location, StopCorner, ToCorner, LastHit.Location);
+				if (Barycentric.GetMin() <= KINDA_SMALL_NUMBER)
+				{
+					continue;
+				}
+				FVector CandidateStopCorner;
+				if (!GetSweepEdgeCrossing(LastHit.Location, Candidate.Location, StopCorner, ToCorner, CandidateStopCorner))
+				{
+					continue;
+				}
+				const double StopDistanceSquared = FVector::DistSquared(StopCorner, CandidateStopCorner);
+				if (StopDistanceSquared < NextStopDistanceSquared)
+				{
+					NextIndex = CandidateIndex;
+					NextStopCorner = CandidateStopCorner;
+					NextStopDistanceSquared = StopDistanceSquared;
+				}
+			}
+			if (NextIndex == INDEX_NONE)
+			{
+				break;
+			}
+			IsUsed[NextIndex] = true;
+			FHitData& NextHit = OutHitChain.Add_GetRef(Candidates[NextIndex]);
+			NextHit.OnSweepEdgeLocation = NextStopCorner;
+			NextHit.bIsChained = true;
+			NextHit.ChainOriginLocation = StopCorner;
+			StopCorner = NextStopCorner;
+		}
+		return StopCorner;
+	}
+
+	static void BuildLocalEdgeSearch(
+		const FPoint& PointA
+		, const FPoint& PointB
+		, const TArray<FTautRopeCollisionShape>& Shapes
+		, const int32 Hops
+		, FLocalEdgeSearch& OutLocalEdgeSearch
+	)
+	{
+		OutLocalEdgeSearch.ShapeIndex = INDEX_NONE;
+		OutLocalEdgeSearch.EdgeIndices.Reset();
+		if (Hops <= 0 || PointA.ShapeIndex == INDEX_NONE || PointA.ShapeIndex != PointB.ShapeIndex)
+		{
+			return;
+		}
+		const FTautRopeCollisionShape& Shape = Shapes[PointA.ShapeIndex];
+		if (Shape.IsCurved())
+		{
+			return;
+		}
+		const FTautRopeCollisionShape& Geometry = Shape.GetGeometry();
+		TArray<int32>& EdgeIndices = OutLocalEdgeSearch.EdgeIndices;
+		TBitArray<> IsReached(false, Geometry.Edges.Num());
+		auto ReachEdge = [&EdgeIndices, &IsReached](const int32 EdgeIndex)
+			{
+				if (!IsReached[EdgeIndex])
+				{
+					IsReached[EdgeIndex] = true;
+					EdgeIndices.Add(EdgeIndex);
+				}
+			};
+		for (const FPoint* Point : { &PointA, &PointB })
+		{
+			if (Point->EdgeIndex != INDEX_NONE)
+			{
+				ReachEdge(Point->EdgeIndex);
+			}
+			if (Point->VertIndex != INDEX_NONE)
+			{
+				for (const int32 EdgeIndex : Geometry.VertToEdges[Point->VertIndex].Edges)
+				{
+					ReachEdge(EdgeIndex);
+				}
+			}
+		}
+		if (EdgeIndices.IsEmpty())
+		{
+			return;
+		}
+		// Each hop adds the edges sharing a vertex with the edges of the hop before.
+		int32 FrontierStart = 0;
+		for (int32 Hop = 0; Hop < Hops; ++Hop)
+		{
+			const int32 FrontierEnd = EdgeIndices.Num();
+			for (int32 i = FrontierStart; i < FrontierEnd; ++i)
+			{
+				const FIntVector2& Edge = Geometry.Edges[EdgeIndices[i]];
+				for (const int32 EdgeIndex : Geometry.VertToEdges[Edge.X].Edges)
+				{
+					ReachEdge(EdgeIndex);
+				}
+				for (const int32 EdgeIndex : Geometry.VertToEdges[Edge.Y].Edges)
+				{
+					ReachEdge(EdgeIndex);
+				}
+			}
+			FrontierStart = FrontierEnd;
+		}
+		FBox Bounds(ForceInit);
+		for (const int32 EdgeIndex : EdgeIndices)
+		{
+			Bounds += Shape.GetLocalVertex(Geometry.Edges[EdgeIndex].X);
+			Bounds += Shape.GetLocalVertex(Geometry.Edges[EdgeIndex].Y);
+		}
+		Bounds = Bounds.ExpandBy(TAUT_ROPE_DISTANCE_TOLERANCE);
+		// A triangle inside the bounds can still cross the shape's other edges running through them, e.g. on a concave
+		// cell of mesh edges, so the search only stays local when no other edge reaches into the bounds.
+		if (Shape.IsAnyEdgeOverlapping(Bounds, IsReached))
+		{
+			EdgeIndices.Reset();
+			return;
+		}
+		OutLocalEdgeSearch.Bounds = Bounds;
+		OutLocalEdgeSearch.ShapeIndex = PointA.ShapeIndex;
+	}
+
 	void SweepSegmentThroughShapes(
-		FHitData& OutHitData,
+		TArray<FHitData>& OutHitChain,
 		FPoint& InOutSegmentPointA,
 		FPoint& InOutSegmentPointB,
 		const FVector& OriginLocationA,
@@ -94,14 +363,21 @@ namespace TautRope
 		const FVector& TargetLocationA,
 		const FVector& TargetLocationB,
 		const TArray<FTautRopeCollisionShape>& Shapes,
-		const int32 RopePointIndex
+		const int32 RopePointIndex,
+		const int32 MaxChainHits,
+		const int32 LocalSearchHops
 #if TAUT_ROPE_DEBUG_DRAWING
 		, const UWorld* World
 		, const bool bIsDebugDrawingActive
 #endif
 	)
 	{
-		OutHitData.SweepRatio = MAX_FLT;
+		OutHitChain.Reset();
+		TArray<FHitData> ChainCandidates;
+		TArray<FHitData>* OutChainCandidates = MaxChainHits > 1 ? &ChainCandidates : nullptr;
+		FLocalEdgeSearch LocalEdgeSearch;
+		BuildLocalEdgeSearch(InOutSegmentPointA, InOutSegmentPointB, Shapes, LocalSearchHops, LocalEdgeSearch);
+		FHitData HitData;
 		// First perform triangle sweep for A-movement
 		for (int32 ShapeIndex = 0; ShapeIndex < Shapes.Num(); ++ShapeIndex)
 		{
@@ -120,15 +396,17 @@ namespace TautRope
 				InOutSegmentPointB.VertIndex,	// VertIndexPointB
 				RopePointIndex,
 				true,	// bIsFirstTriangleSweep
-				OutHitData
+				HitData,
+				OutChainCandidates,
+				&LocalEdgeSearch
 			);
 		}
 #if TAUT_ROPE_DEBUG_DRAWING
 		if (IsValid(World) && bIsDebugDrawingActive)
 		{
-			if (OutHitData.bIsHit)
+			if (HitData.bIsHit)
 			{
-				DebugDrawSweep(World, OriginLocationA, OutHitData.OnSweepEdgeLocation, OriginLocationB, true);
+				DebugDrawSweep(World, OriginLocationA, HitData.OnSweepEdgeLocation, OriginLocationB, true);
 			}
 			else
 			{
@@ -136,16 +414,19 @@ namespace TautRope
 			}
 		}
 #endif
-		if (OutHitData.bIsHit)
+		if (HitData.bIsHit)
 		{
-			InOutSegmentPointA.Location = OutHitData.OnSweepEdgeLocation;
+			InOutSegmentPointA.Location = BuildHitChain(HitData, ChainCandidates, TargetLocationA, MaxChainHits, OutHitChain);
+			// The chain runs outward from B, so the last contact sits next to A.
+			Algo::Reverse(OutHitChain);
 			return;
 		}
 
 		// No new collisions from A-movement triangle sweep
 		InOutSegmentPointA.Location = TargetLocationA;
 
-		OutHitData.SweepRatio = MAX_FLT;
+		HitData = FHitData();
+		ChainCandidates.Reset();
 		// Perform triangle sweep for B-movement
 		for (int32 ShapeIndex = 0; ShapeIndex < Shapes.Num(); ++ShapeIndex)
 		{
@@ -164,15 +445,17 @@ namespace TautRope
 				InOutSegmentPointB.VertIndex,	// VertIndexPointB
 				RopePointIndex,
 				false,	// bIsFirstTriangleSweep
-				OutHitData
+				HitData,
+				OutChainCandidates,
+				&LocalEdgeSearch
 			);
 		}
 #if TAUT_ROPE_DEBUG_DRAWING
 		if (IsValid(World) && bIsDebugDrawingActive)
 		{
-			if (OutHitData.bIsHit)
+			if (HitData.bIsHit)
 			{
-				DebugDrawSweep(World, OriginLocationB, OutHitData.OnSweepEdgeLocation, TargetLocationA, true);
+				DebugDrawSweep(World, OriginLocationB, HitData.OnSweepEdgeLocation, TargetLocationA, true);
 			}
 			else
 			{
@@ -180,9 +463,9 @@ namespace TautRope
 			}
 		}
 #endif
-		if (OutHitData.bIsHit)
+		if (HitData.bIsHit)
 		{
-			InOutSegmentPointB.Location = OutHitData.OnSweepEdgeLocation;
+			InOutSegmentPointB.Location = BuildHitChain(HitData, ChainCandidates, TargetLocationB, MaxChainHits, OutHitChain);
 			return;
 		}
 
@@ -191,7 +474,152 @@ namespace TautRope
 	}
 
 
-	void SweepSegmentTriangleAgainstShape(
+	// Moves a hit found in a local space shape's frame back to world space.
+	static void LocalHitDataToWorld(
+		FHitData& InOutHitData
+		, const FTautRopeCollisionShape& Shape
+		, const FVector& FromCorner
+		, const FVector& ToCorner
+		, const FVector& LocalFromCorner
+		, const FVector& LocalToCorner
+	)
+	{
+		// The sweep ratio scales with the swept edge length, which differs between the two frames under relative motion.
+		const float SweepAlpha = InOutHitData.SweepRatio * FVector::Dist(LocalFromCorner, LocalToCorner);
+		InOutHitData.Location = Shape.Transform.TransformPositionNoScale(InOutHitData.Location);
+		InOutHitData.OnSweepEdgeLocation = FMath::Lerp(FromCorner, ToCorner, SweepAlpha);
+		InOutHitData.SweepRatio = SweepAlpha / FMath::Max(FVector::Dist(FromCorner, ToCorner), UE_SMALL_NUMBER);
+	}
+
+	// Separating axis test of a triangle against a box centered at the origin of its frame, on the box axes and the triangle normal.
+	static bool IsTriangleOverlappingBox(
+		const FVector& TriA
+		, const FVector& TriB
+		, const FVector& TriC
+		, const FVector& BoxExtent
+	)
+	{
+		const FVector Extent = BoxExtent + FVector(TAUT_ROPE_DISTANCE_TOLERANCE);
+		const FVector TriMin = TriA.ComponentMin(TriB).ComponentMin(TriC);
+		const FVector TriMax = TriA.ComponentMax(TriB).ComponentMax(TriC);
+		if (TriMin.X > Extent.X || TriMin.Y > Extent.Y || TriMin.Z > Extent.Z
+			|| TriMax.X < -Extent.X || TriMax.Y < -Extent.Y || TriMax.Z < -Extent.Z)
+		{
+			return false;
+		}
+		const FVector Normal = FVector::CrossProduct(TriB - TriA, TriC - TriA);
+		const double ProjectedExtent = Extent.X * FMath::Abs(Normal.X) + Extent.Y * FMath::Abs(Normal.Y) + Extent.Z * FMath::Abs(Normal.Z);
+		return FMath::Abs(FVector::DotProduct(Normal, TriA)) <= ProjectedExtent;
+	}
+
+	// Boxes are tested against their extent, other shapes against the bounds of their edges when those are built.
+	static bool IsTriangleReachingShapeEdges(
+		const FVector& TriA
+		, const FVector& TriB
+		, const FVector& TriC
+		, const FTautRopeCollisionShape& Shape
+	)
+	{
+		if (Shape.Type == ETautRopeCollisionShapeType::Box)
+		{
+			return IsTriangleOverlappingBox(TriA, TriB, TriC, Shape.BoxExtent);
+		}
+		if (!Shape.EdgeBounds.IsValid)
+		{
+			return true;
+		}
+		const FVector Center = Shape.EdgeBounds.GetCenter();
+		return IsTriangleOverlappingBox(TriA - Center, TriB - Center, TriC - Center, Shape.EdgeBounds.GetExtent());
+	}
+
+	// A swept triangle in a shape's frame, also rebased once next to the shape's float edges when it is close enough.
+	struct FSweepTriangle
+	{
+		FSweepTriangle(
+			const FVector& InFromCorner
+			, const FVector& InToCorner
+			, const FVector& InSupportCorner
+			, const FTautRopeCollisionShape& Shape
+		)
+			: FromCorner(InFromCorner)
+			, ToCorner(InToCorner)
+			, SupportCorner(InSupportCorner)
+		{
+#if TAUT_ROPE_FLOAT_SWEEP_KERNEL
+			const FTautRopeCollisionShape& Kernel = Shape.GetKernelShape();
+			const FVector KernelFrom = FromCorner - Kernel.KernelOrigin;
+			const FVector KernelTo = ToCorner - Kernel.KernelOrigin;
+			const FVector KernelSupport = SupportCorner - Kernel.KernelOrigin;
+			const double MaxCoordinate = FMath::Max3(KernelFrom.GetAbsMax(), KernelTo.GetAbsMax(), KernelSupport.GetAbsMax());
+			bUseKernel = !Kernel.KernelEdgeVertices.IsEmpty() && MaxCoordinate <= TAUT_ROPE_FLOAT_KERNEL_MAX_EXTENT;
+			KernelFromCorner = FVector3f(KernelFrom);
+			KernelToCorner = FVector3f(KernelTo);
+			KernelSupportCorner = FVector3f(KernelSupport);
+#endif
+		}
+
+		bool IntersectEdge(
+			const FTautRopeCollisionShape& Shape
+			, const int32 EdgeIndex
+			, FVector& OutLocation
+			, FVector& OutOnSweepEdgeLocation
+			, float& OutSweepRatio
+		) const
+		{
+#if TAUT_ROPE_FLOAT_SWEEP_KERNEL
+			if (bUseKernel)
+			{
+				const FTautRopeCollisionShape& Kernel = Shape.GetKernelShape();
+				FVector3f KernelLocation;
+				FVector3f KernelOnSweepEdgeLocation;
+				const ETriangleLineIntersection KernelIntersection = GetTriangleLineIntersection(
+					KernelFromCorner
+					, KernelToCorner
+					, KernelSupportCorner
+					, Kernel.KernelEdgeVertices[EdgeIndex * 2]
+					, Kernel.KernelEdgeVertices[EdgeIndex * 2 + 1]
+					, KernelLocation
+					, KernelOnSweepEdgeLocation
+					, OutSweepRatio
+				);
+				if (KernelIntersection == ETriangleLineIntersection::None)
+				{
+					return false;
+				}
+				if (KernelIntersection == ETriangleLineIntersection::Hit)
+				{
+					OutLocation = Kernel.KernelOrigin + FVector(KernelLocation);
+					OutOnSweepEdgeLocation = Kernel.KernelOrigin + FVector(KernelOnSweepEdgeLocation);
+					return true;
+				}
+				// Nearly parallel edges are swept again in double precision.
+			}
+#endif
+			const FIntVector2& EdgeVerts = Shape.GetGeometry().Edges[EdgeIndex];
+			return ETriangleLineIntersection::Hit == GetTriangleLineIntersection(
+				FromCorner
+				, ToCorner
+				, SupportCorner
+				, Shape.GetLocalVertex(EdgeVerts.X)
+				, Shape.GetLocalVertex(EdgeVerts.Y)
+				, OutLocation
+				, OutOnSweepEdgeLocation
+				, OutSweepRatio
+			);
+		}
+
+		const FVector& FromCorner;
+		const FVector& ToCorner;
+		const FVector& SupportCorner;
+#if TAUT_ROPE_FLOAT_SWEEP_KERNEL
+		bool bUseKernel = false;
+		FVector3f KernelFromCorner;
+		FVector3f KernelToCorner;
+		FVector3f KernelSupportCorner;
+#endif
+	};
+
+	static void SweepSegmentTriangleAgainstShapeEdges(
 		const FVector& FromCorner,
 		const FVector& ToCorner,
 		const FVector& SupportCorner,
@@ -205,17 +633,62 @@ namespace TautRope
 		const int32 VertIndexPointB,
 		const int32 RopePointIndex,
 		const bool bIsFirstTriangleSweep,
-		FHitData& OutHitData
+		FHitData& OutHitData,
+		TArray<FHitData>* OutAllHits,
+		const FLocalEdgeSearch* LocalEdgeSearch
 	)
 	{
-		for (int32 EdgeIndex = 0; EdgeIndex < Shape.Edges.Num(); ++EdgeIndex)
+		if (Shape.IsCurved())
 		{
+			// Segments from an entry or exit point are tangent to their own shape.
+			if (ShapeIndex == ShapeIndexPointA || ShapeIndex == ShapeIndexPointB)
+			{
+				return;
+			}
+			FVector ContactLocation;
+			FVector OnSweepEdgeLocation;
+			float SweepAlpha = 0.f;
+			if (SweepTriangleAgainstCurvedShape(FromCorner, ToCorner, SupportCorner, Shape, ContactLocation, OnSweepEdgeLocation, SweepAlpha))
+			{
+				// Same units as the ratio from GetTriangleLineIntersection.
+				const float SweepRatio = SweepAlpha / FMath::Max(FVector::Dist(FromCorner, ToCorner), UE_SMALL_NUMBER);
+				if (SweepRatio < OutHitData.SweepRatio)
+				{
+					OutHitData.bIsHit = true;
+					OutHitData.Location = ContactLocation;
+					OutHitData.OnSweepEdgeLocation = OnSweepEdgeLocation;
+					OutHitData.SweepRatio = SweepRatio;
+					OutHitData.bIsHitOnFirstTriangleSweep = bIsFirstTriangleSweep;
+					OutHitData.RopePointIndex = RopePointIndex;
+					OutHitData.EdgeIndex = INDEX_NONE;
+					OutHitData.ShapeIndex = ShapeIndex;
+				}
+			}
+			return;
+		}
+		if (!IsTriangleReachingShapeEdges(FromCorner, ToCorner, SupportCorner, Shape))
+		{
+			return;
+		}
+		const FTautRopeCollisionShape& Geometry = Shape.GetGeometry();
+		const FSweepTriangle SweepTriangle(FromCorner, ToCorner, SupportCorner, Shape);
+		// Contacts slide onto the edges around them, so while the triangle stays among those only they are tested.
+		// The corners are the ones the edges are intersected with, in the space of GetLocalVertex like the bounds.
+		const bool bIsLocalSearch = LocalEdgeSearch != nullptr
+			&& LocalEdgeSearch->ShapeIndex == ShapeIndex
+			&& LocalEdgeSearch->Bounds.IsInsideOrOn(SweepTriangle.FromCorner)
+			&& LocalEdgeSearch->Bounds.IsInsideOrOn(SweepTriangle.ToCorner)
+			&& LocalEdgeSearch->Bounds.IsInsideOrOn(SweepTriangle.SupportCorner);
+		const int32 NumSweptEdges = bIsLocalSearch ? LocalEdgeSearch->EdgeIndices.Num() : Geometry.Edges.Num();
+		for (int32 SweptEdge = 0; SweptEdge < NumSweptEdges; ++SweptEdge)
+		{
+			const int32 EdgeIndex = bIsLocalSearch ? LocalEdgeSearch->EdgeIndices[SweptEdge] : SweptEdge;
 			if (ShapeIndex == ShapeIndexPointA)
 			{
 				if (EdgeIndex == EdgeIndexPointA)
 					continue;
 
-				if (VertIndexPointA != INDEX_NONE && Shape.VertToEdges[VertIndexPointA].Edges.Contains(EdgeIndex))
+				if (VertIndexPointA != INDEX_NONE && Geometry.VertToEdges[VertIndexPointA].Edges.Contains(EdgeIndex))
 					continue;
 			}
 
@@ -224,42 +697,93 @@ namespace TautRope
 				if (EdgeIndex == EdgeIndexPointB)
 					continue;
 
-				if (VertIndexPointB != INDEX_NONE && Shape.VertToEdges[VertIndexPointB].Edges.Contains(EdgeIndex))
+				if (VertIndexPointB != INDEX_NONE && Geometry.VertToEdges[VertIndexPointB].Edges.Contains(EdgeIndex))
 					continue;
 			}
 
-			const FIntVector2& EdgeVerts = Shape.Edges[EdgeIndex];
-			const FVector& EdgeA = Shape.Vertices[EdgeVerts.X];
-			const FVector& EdgeB = Shape.Vertices[EdgeVerts.Y];
-
 			FVector ClosestPointOnLine;
 			FVector OnSweepEdgeLocation;
 			float SweepRatio = MAX_FLT;
-			const bool bIsIntersection = GetTriangleLineIntersection(
-				FromCorner
-				, ToCorner
-				, SupportCorner
-				, EdgeA
-				, EdgeB
-				, ClosestPointOnLine
-				, OnSweepEdgeLocation
-				, SweepRatio
-			);
+			const bool bIsIntersection = SweepTriangle.IntersectEdge(Shape, EdgeIndex, ClosestPointOnLine, OnSweepEdgeLocation, SweepRatio);
 
-			if (bIsIntersection && SweepRatio < OutHitData.SweepRatio)
+			if (!bIsIntersection)
 			{
-				OutHitData.bIsHit = true;
-				OutHitData.Location = ClosestPointOnLine;
-				OutHitData.OnSweepEdgeLocation = OnSweepEdgeLocation;
-				OutHitData.SweepRatio = SweepRatio;
-				OutHitData.bIsHitOnFirstTriangleSweep = bIsFirstTriangleSweep;
-				OutHitData.RopePointIndex = RopePointIndex;
-				OutHitData.EdgeIndex = EdgeIndex;
-				OutHitData.ShapeIndex = ShapeIndex;
+				continue;
+			}
+			FHitData EdgeHitData;
+			EdgeHitData.bIsHit = true;
+			EdgeHitData.Location = ClosestPointOnLine;
+			EdgeHitData.OnSweepEdgeLocation = OnSweepEdgeLocation;
+			EdgeHitData.SweepRatio = SweepRatio;
+			EdgeHitData.bIsHitOnFirstTriangleSweep = bIsFirstTriangleSweep;
+			EdgeHitData.RopePointIndex = RopePointIndex;
+			EdgeHitData.EdgeIndex = EdgeIndex;
+			EdgeHitData.ShapeIndex = ShapeIndex;
+			if (OutAllHits)
+			{
+				OutAllHits->Add(EdgeHitData);
+			}
+			if (SweepRatio < OutHitData.SweepRatio)
+			{
+				OutHitData = EdgeHitData;
 			}
 		}
 	}
-	void SweepRemoveTriangleAgainstShape(
+
+	void SweepSegmentTriangleAgainstShape(
+		const FVector& FromCorner,
+		const FVector& ToCorner,
+		const FVector& SupportCorner,
+		const FTautRopeCollisionShape& Shape,
+		const int32 ShapeIndex,
+		const int32 ShapeIndexPointA,
+		const int32 ShapeIndexPointB,
+		const int32 EdgeIndexPointA,
+		const int32 EdgeIndexPointB,
+		const int32 VertIndexPointA,
+		const int32 VertIndexPointB,
+		const int32 RopePointIndex,
+		const bool bIsFirstTriangleSweep,
+		FHitData& OutHitData,
+		TArray<FHitData>* OutAllHits,
+		const FLocalEdgeSearch* LocalEdgeSearch
+	)
+	{
+		if (!Shape.bIsLocalSpace)
+		{
+			SweepSegmentTriangleAgainstShapeEdges(
+				FromCorner, ToCorner, SupportCorner, Shape, ShapeIndex
+				, ShapeIndexPointA, ShapeIndexPointB, EdgeIndexPointA, EdgeIndexPointB, VertIndexPointA, VertIndexPointB
+				, RopePointIndex, bIsFirstTriangleSweep, OutHitData, OutAllHits, LocalEdgeSearch
+			);
+			return;
+		}
+		// Only the swept triangle is moved into the shape's frame. Origin corners are taken relative to where the shape was
+		// and target corners relative to where it is now, so the triangle covers the relative motion.
+		// The support corner is an origin on the first triangle sweep and a target on the second.
+		const FVector LocalFromCorner = Shape.PrevTransform.InverseTransformPositionNoScale(FromCorner);
+		const FVector LocalToCorner = Shape.Transform.InverseTransformPositionNoScale(ToCorner);
+		const FVector LocalSupportCorner = bIsFirstTriangleSweep
+			? Shape.PrevTransform.InverseTransformPositionNoScale(SupportCorner)
+			: Shape.Transform.InverseTransformPositionNoScale(SupportCorner);
+		FHitData ShapeHitData;
+		SweepSegmentTriangleAgainstShapeEdges(
+			LocalFromCorner, LocalToCorner, LocalSupportCorner, Shape, ShapeIndex
+			, ShapeIndexPointA, ShapeIndexPointB, EdgeIndexPointA, EdgeIndexPointB, VertIndexPointA, VertIndexPointB
+			, RopePointIndex, bIsFirstTriangleSweep, ShapeHitData, nullptr, LocalEdgeSearch
+		);
+		if (!ShapeHitData.bIsHit)
+		{
+			return;
+		}
+		LocalHitDataToWorld(ShapeHitData, Shape, FromCorner, ToCorner, LocalFromCorner, LocalToCorner);
+		if (ShapeHitData.SweepRatio < OutHitData.SweepRatio)
+		{
+			OutHitData = ShapeHitData;
+		}
+	}
+
+	static void SweepRemoveTriangleAgainstShapeEdges(
 		const FVector& FromCorner
 		, const FVector& ToCorner
 		, const FVector& SupportCorner
@@ -269,29 +793,46 @@ namespace TautRope
 		, FHitData& OutHitData
 	)
 	{
-		for (int32 EdgeIndex = 0; EdgeIndex < Shape.Edges.Num(); ++EdgeIndex)
+		if (Shape.IsCurved())
+		{
+			if (IgnoredEdges.Contains(FIntVector2(ShapeIndex, INDEX_NONE)))
+			{
+				return;
+			}
+			FVector ContactLocation;
+			FVector OnSweepEdgeLocation;
+			float SweepAlpha = 0.f;
+			if (SweepTriangleAgainstCurvedShape(FromCorner, ToCorner, SupportCorner, Shape, ContactLocation, OnSweepEdgeLocation, SweepAlpha))
+			{
+				const float SweepRatio = SweepAlpha / FMath::Max(FVector::Dist(FromCorner, ToCorner), UE_SMALL_NUMBER);
+				if (SweepRatio < OutHitData.SweepRatio)
+				{
+					OutHitData.bIsHit = true;
+					OutHitData.Location = ContactLocation;
+					OutHitData.OnSweepEdgeLocation = OnSweepEdgeLocation;
+					OutHitData.SweepRatio = SweepRatio;
+					OutHitData.EdgeIndex = INDEX_NONE;
+					OutHitData.ShapeIndex = ShapeIndex;
+				}
+			}
+			return;
+		}
+		if (!IsTriangleReachingShapeEdges(FromCorner, ToCorner, SupportCorner, Shape))
+		{
+			return;
+		}
+		const FTautRopeCollisionShape& Geometry = Shape.GetGeometry();
+		const FSweepTriangle SweepTriangle(FromCorner, ToCorner, SupportCorner, Shape);
+		for (int32 EdgeIndex = 0; EdgeIndex < Geometry.Edges.Num(); ++EdgeIndex)
 		{
 			if (IgnoredEdges.Contains(FIntVector2(ShapeIndex, EdgeIndex)))
 			{
 				continue;
 			}
-			const FIntVector2& EdgeVerts = Shape.Edges[EdgeIndex];
-			const FVector& EdgeA = Shape.Vertices[EdgeVerts.X];
-			const FVector& EdgeB = Shape.Vertices[EdgeVerts.Y];
-
 			FVector ClosestPointOnLine;
 			FVector OnSweepEdgeLocation;
 			float SweepRatio = MAX_FLT;
-			const bool bIsIntersection = GetTriangleLineIntersection(
-				FromCorner
-				, ToCorner
-				, SupportCorner
-				, EdgeA
-				, EdgeB
-				, ClosestPointOnLine
-				, OnSweepEdgeLocation
-				, SweepRatio
-			);
+			const bool bIsIntersection = SweepTriangle.IntersectEdge(Shape, EdgeIndex, ClosestPointOnLine, OnSweepEdgeLocation, SweepRatio);
 			if (bIsIntersection && SweepRatio < OutHitData.SweepRatio)
 			{
 				OutHitData.bIsHit = true;
@@ -304,17 +845,52 @@ namespace TautRope
 		}
 	}
 
-	bool GetTriangleLineIntersection(
-		const FVector& FromCorner,
-		const FVector& ToCorner,
-		const FVector& SupportCorner,
-		const FVector& LineA,
-		const FVector& LineB,
-		FVector& OutLocation,
-		FVector& OutOnSweepEdgeLocation,
+	void SweepRemoveTriangleAgainstShape(
+		const FVector& FromCorner
+		, const FVector& ToCorner
+		, const FVector& SupportCorner
+		, const FTautRopeCollisionShape& Shape
+		, const int32 ShapeIndex
+		, const TArray<FIntVector2>& IgnoredEdges
+		, FHitData& OutHitData
+	)
+	{
+		if (!Shape.bIsLocalSpace)
+		{
+			SweepRemoveTriangleAgainstShapeEdges(FromCorner, ToCorner, SupportCorner, Shape, ShapeIndex, IgnoredEdges, OutHitData);
+			return;
+		}
+		// Pruning happens after the shapes have moved, so every corner is relative to the current transform.
+		const FVector LocalFromCorner = Shape.Transform.InverseTransformPositionNoScale(FromCorner);
+		const FVector LocalToCorner = Shape.Transform.InverseTransformPositionNoScale(ToCorner);
+		const FVector LocalSupportCorner = Shape.Transform.InverseTransformPositionNoScale(SupportCorner);
+		FHitData ShapeHitData;
+		SweepRemoveTriangleAgainstShapeEdges(LocalFromCorner, LocalToCorner, LocalSupportCorner, Shape, ShapeIndex, IgnoredEdges, ShapeHitData);
+		if (!ShapeHitData.bIsHit)
+		{
+			return;
+		}
+		LocalHitDataToWorld(ShapeHitData, Shape, FromCorner, ToCorner, LocalFromCorner, LocalToCorner);
+		if (ShapeHitData.SweepRatio < OutHitData.SweepRatio)
+		{
+			OutHitData = ShapeHitData;
+		}
+	}
+
+	template<typename FReal>
+	ETriangleLineIntersection GetTriangleLineIntersection(
+		const UE::Math::TVector<FReal>& FromCorner,
+		const UE::Math::TVector<FReal>& ToCorner,
+		const UE::Math::TVector<FReal>& SupportCorner,
+		const UE::Math::TVector<FReal>& LineA,
+		const UE::Math::TVector<FReal>& LineB,
+		UE::Math::TVector<FReal>& OutLocation,
+		UE::Math::TVector<FReal>& OutOnSweepEdgeLocation,
 		float& OutSweepRatio
 	)
 	{
+		using FVector = UE::Math::TVector<FReal>;
+
 		// --- Step 1: Möller–Trumbore triangle-line intersection ---
 		const FVector Dir = LineB - LineA;
 		const FVector Edge1 = ToCorner - FromCorner;
@@ -324,7 +900,16 @@ namespace TautRope
 		const float Det = FVector::DotProduct(Edge1, PVec);
 		if (FMath::Abs(Det) < KINDA_SMALL_NUMBER)
 		{
-			return false; // Line parallel to triangle
+			return ETriangleLineIntersection::None; // Line parallel to triangle
+		}
+		if constexpr (std::is_same_v<FReal, float>)
+		{
+			// Dividing by a small determinant magnifies the float rounding beyond the tolerance the kernel is sized for.
+			const float DetScaleSquared = Edge1.SizeSquared() * Dir.SizeSquared() * Edge2.SizeSquared();
+			if (FMath::Square(Det) < FMath::Square(TAUT_ROPE_FLOAT_KERNEL_MIN_RELATIVE_DET) * DetScaleSquared)
+			{
+				return ETriangleLineIntersection::IllConditioned;
+			}
 		}
 
 		const float InvDet = 1.0f / Det;
@@ -333,20 +918,20 @@ namespace TautRope
 		const float U = FVector::DotProduct(TVec, PVec) * InvDet;
 		if (U < 0.f || U > 1.0f)
 		{
-			return false;
+			return ETriangleLineIntersection::None;
 		}
 
 		const FVector QVec = FVector::CrossProduct(TVec, Edge1);
 		const float V = FVector::DotProduct(Dir, QVec) * InvDet;
 		if (V < 0.f || U + V > 1.0f)
 		{
-			return false;
+			return ETriangleLineIntersection::None;
 		}
 
 		const float T = FVector::DotProduct(Edge2, QVec) * InvDet;
 		if (T < 0.f || T > 1.f)
 		{
-			return false;
+			return ETriangleLineIntersection::None;
 		}
 
 		OutLocation = LineA + Dir * T;
@@ -377,9 +962,14 @@ namespace TautRope
 			OutOnSweepEdgeLocation = FromCorner;
 		}
 
-		return true;
+		return ETriangleLineIntersection::Hit;
 	}
 
+	template ETriangleLineIntersection GetTriangleLineIntersection<double>(
+		const FVector&, const FVector&, const FVector&, const FVector&, const FVector&, FVector&, FVector&, float&);
+	template ETriangleLineIntersection GetTriangleLineIntersection<float>(
+		const FVector3f&, const FVector3f&, const FVector3f&, const FVector3f&, const FVector3f&, FVector3f&, FVector3f&, float&);
+
 #if TAUT_ROPE_DEBUG_DRAWING
 	void DebugDrawSweep(
 		const UWorld* World
@@ -0,0 +1,334 @@
+#include "TautRopeHelpersCurved.h"
+#include "TautRopeConfig.h"
+#include "TautRopePoint.h"
+
+namespace TautRope
+{
+	bool IsCurvedWrapSegment(
+		const TArray<FPoint>& RopePoints
+		, const int32 PointIndex
+		, const TArray<FTautRopeCollisionShape>& Shapes
+	)
+	{
+		if (!RopePoints.IsValidIndex(PointIndex + 1))
+		{
+			return false;
+		}
+		const int32 ShapeIndex = RopePoints[PointIndex].ShapeIndex;
+		return ShapeIndex != INDEX_NONE
+			&& ShapeIndex == RopePoints[PointIndex + 1].ShapeIndex
+			&& Shapes[ShapeIndex].IsCurved();
+	}
+
+	float GetRopeSegmentLength(
+		const TArray<FPoint>& RopePoints
+		, const int32 PointIndex
+		, const TArray<FTautRopeCollisionShape>& Shapes
+	)
+	{
+		const FVector& A = RopePoints[PointIndex].Location;
+		const FVector& B = RopePoints[PointIndex + 1].Location;
+		if (IsCurvedWrapSegment(RopePoints, PointIndex, Shapes))
+		{
+			const FVector& Before = PointIndex > 0 ? RopePoints[PointIndex - 1].Location : A;
+			return GetCurvedWrapLength(Shapes[RopePoints[PointIndex].ShapeIndex], Before, A, B);
+		}
+		return FVector::Dist(A, B);
+	}
+
+	FVector GetClosestCurvedCorePoint(
+		const FTautRopeCollisionShape& Shape
+		, const FVector& LocalA
+		, const FVector& LocalB
+		, FVector& OutClosestOnSegment
+	)
+	{
+		if (Shape.Type == ETautRopeCollisionShapeType::Capsule)
+		{
+			FVector ClosestOnAxis;
+			FMath::SegmentDistToSegmentSafe(
+				FVector(0., 0., -Shape.HalfLength)
+				, FVector(0., 0., Shape.HalfLength)
+				, LocalA
+				, LocalB
+				, ClosestOnAxis
+				, OutClosestOnSegment
+			);
+			return ClosestOnAxis;
+		}
+		OutClosestOnSegment = FMath::ClosestPointOnSegment(FVector::ZeroVector, LocalA, LocalB);
+		return FVector::ZeroVector;
+	}
+
+	static FVector GetCurvedWrapCenter(
+		const FTautRopeCollisionShape& Shape
+		, const FVector& A
+		, const FVector& B
+	)
+	{
+		FVector ClosestOnSegment;
+		const FVector LocalCore = GetClosestCurvedCorePoint(
+			Shape
+			, Shape.Transform.InverseTransformPositionNoScale(A)
+			, Shape.Transform.InverseTransformPositionNoScale(B)
+			, ClosestOnSegment
+		);
+		return Shape.Transform.TransformPositionNoScale(LocalCore);
+	}
+
+	bool IsSegmentClearOfCurvedShape(
+		const FVector& A
+		, const FVector& B
+		, const FTautRopeCollisionShape& Shape
+	)
+	{
+		FVector ClosestOnSegment;
+		const FVector LocalCore = GetClosestCurvedCorePoint(
+			Shape
+			, Shape.Transform.InverseTransformPositionNoScale(A)
+			, Shape.Transform.InverseTransformPositionNoScale(B)
+			, ClosestOnSegment
+		);
+		return FVector::Dist(LocalCore, ClosestOnSegment) > Shape.Radius - TAUT_ROPE_DISTANCE_TOLERANCE;
+	}
+
+	// Squared distance between the segment PQ and the triangle ABC, with the closest points on each.
+	static float GetSegmentTriangleDistanceSquared(
+		const FVector& P
+		, const FVector& Q
+		, const FVector& A
+		, const FVector& B
+		, const FVector& C
+		, FVector& OutOnSegment
+		, FVector& OutOnTriangle
+	)
+	{
+		// A segment passing through the triangle touches it.
+		const FVector Normal = FVector::CrossProduct(B - A, C - A);
+		if (Normal.SizeSquared() > UE_SMALL_NUMBER)
+		{
+			const float DistP = FVector::DotProduct(P - A, Normal);
+			const float DistQ = FVector::DotProduct(Q - A, Normal);
+			if (DistP * DistQ <= 0.f && DistP != DistQ)
+			{
+				const FVector Crossing = P + (Q - P) * (DistP / (DistP - DistQ));
+				const FVector Barycentric = FMath::ComputeBaryCentric2D(Crossing, A, B, C);
+				if (Barycentric.GetMin() >= 0.f)
+				{
+					OutOnSegment = Crossing;
+					OutOnTriangle = Crossing;
+					return 0.f;
+				}
+			}
+		}
+
+		float BestDistSquared = UE_BIG_NUMBER;
+		auto Consider = [&](const FVector& OnSegment, const FVector& OnTriangle)
+			{
+				const float DistSquared = FVector::DistSquared(OnSegment, OnTriangle);
+				if (DistSquared < BestDistSquared)
+				{
+					BestDistSquared = DistSquared;
+					OutOnSegment = OnSegment;
+					OutOnTriangle = OnTriangle;
+				}
+			};
+		Consider(P, FMath::ClosestPointOnTriangleToPoint(P, A, B, C));
+		Consider(Q, FMath::ClosestPointOnTriangleToPoint(Q, A, B, C));
+		const FVector Edges[3][2] = { { A, B }, { B, C }, { C, A } };
+		for (const FVector(&Edge)[2] : Edges)
+		{
+			FVector OnSegment;
+			FVector OnEdge;
+			FMath::SegmentDistToSegmentSafe(P, Q, Edge[0], Edge[1], OnSegment, OnEdge);
+			Consider(OnSegment, OnEdge);
+		}
+		return BestDistSquared;
+	}
+
+	bool SweepTriangleAgainstCurvedShape(
+		const FVector& FromCorner
+		, const FVector& ToCorner
+		, const FVector& SupportCorner
+		, const FTautRopeCollisionShape& Shape
+		, FVector& OutContactLocation
+		, FVector& OutOnSweepEdgeLocation
+		, float& OutSweepAlpha
+	)
+	{
+		const FVector CoreStart(0., 0., Shape.Type == ETautRopeCollisionShapeType::Capsule ? -Shape.HalfLength : 0.);
+		const FVector CoreEnd(0., 0., Shape.Type == ETautRopeCollisionShapeType::Capsule ? Shape.HalfLength : 0.);
+
+		// Clearance of the shape from the part of the triangle swept up to Alpha. The swept triangles grow with Alpha,
+		// so the clearance never increases and the first touching alpha can be bisected without skipping thin shapes.
+		auto GetSweptClearance = [&](const float Alpha)
+			{
+				FVector OnCore;
+				FVector OnTriangle;
+				const float DistSquared = GetSegmentTriangleDistanceSquared(
+					CoreStart
+					, CoreEnd
+					, FromCorner
+					, FMath::Lerp(FromCorner, ToCorner, Alpha)
+					, SupportCorner
+					, OnCore
+					, OnTriangle
+				);
+				return FMath::Sqrt(DistSquared) - Shape.Radius;
+			};
+
+		// Segments that already rest on the shape are left to pruning rather than stopped in place.
+		if (GetSweptClearance(0.f) < -TAUT_ROPE_DISTANCE_TOLERANCE)
+		{
+			return false;
+		}
+		if (GetSweptClearance(1.f) >= 0.f)
+		{
+			return false;
+		}
+
+		const float SweepLength = FVector::Dist(FromCorner, ToCorner);
+		float ClearAlpha = 0.f;
+		float TouchingAlpha = 1.f;
+		for (int32 Bisection = 0; Bisection < TAUT_ROPE_CURVED_SWEEP_BISECTIONS && (TouchingAlpha - ClearAlpha) * SweepLength > TAUT_ROPE_DISTANCE_TOLERANCE; ++Bisection)
+		{
+			const float Alpha = (ClearAlpha + TouchingAlpha) * 0.5f;
+			if (GetSweptClearance(Alpha) < 0.f)
+			{
+				TouchingAlpha = Alpha;
+			}
+			else
+			{
+				ClearAlpha = Alpha;
+			}
+		}
+
+		FVector ClosestOnSegment;
+		const FVector Core = GetClosestCurvedCorePoint(Shape, FMath::Lerp(FromCorner, ToCorner, ClearAlpha), SupportCorner, ClosestOnSegment);
+		OutContactLocation = Core + (ClosestOnSegment - Core).GetSafeNormal() * (Shape.Radius + TAUT_ROPE_DISTANCE_TOLERANCE);
+		OutOnSweepEdgeLocation = FMath::Lerp(FromCorner, ToCorner, ClearAlpha);
+		OutSweepAlpha = ClearAlpha;
+		return true;
+	}
+
+	static FVector GetTangentPoint(
+		const FVector& Center
+		, const float Radius
+		, const FVector& Point
+		, const FVector& Side
+	)
+	{
+		const FVector ToPoint = Point - Center;
+		const float Dist = ToPoint.Size();
+		if (Dist < KINDA_SMALL_NUMBER)
+		{
+			return Center + Side * Radius;
+		}
+		const FVector Dir = ToPoint / Dist;
+		if (Dist <= Radius)
+		{
+			return Center + Dir * Radius;
+		}
+		const float CosAngle = Radius / Dist;
+		const float SinAngle = FMath::Sqrt(FMath::Max(0.f, 1.f - CosAngle * CosAngle));
+		const FVector Perpendicular = (Side - Dir * FVector::DotProduct(Side, Dir)).GetSafeNormal();
+		return Center + (Dir * CosAngle + Perpendicular * SinAngle) * Radius;
+	}
+
+	void SolveCurvedWrap(
+		const FTautRopeCollisionShape& Shape
+		, const FVector& A
+		, const FVector& C
+		, const FVector& Entry
+		, const FVector& Exit
+		, FVector& OutEntry
+		, FVector& OutExit
+	)
+	{
+		const FVector Center = GetCurvedWrapCenter(Shape, A, C);
+		const float WrapRadius = Shape.Radius + TAUT_ROPE_DISTANCE_TOLERANCE;
+
+		// The side the rope wraps on now picks which of the two tangents from each end is taken.
+		FVector Side = (Entry + Exit) * 0.5f - Center;
+		if (Side.IsNearlyZero())
+		{
+			Side = Entry - Center;
+		}
+		FVector PlaneNormal = FVector::CrossProduct(A - Center, C - Center);
+		if (PlaneNormal.IsNearlyZero())
+		{
+			PlaneNormal = FVector::CrossProduct(A - Center, Side);
+		}
+		Side = FVector::VectorPlaneProject(Side, PlaneNormal.GetSafeNormal()).GetSafeNormal();
+
+		OutEntry = GetTangentPoint(Center, WrapRadius, A, Side);
+		OutExit = GetTangentPoint(Center, WrapRadius, C, Side);
+	}
+
+	// Angle from entry to exit in the direction the rope arriving from Before runs around the center, in [0, 2 PI).
+	static float GetCurvedWrapAngle(
+		const FVector& Center
+		, const FVector& Before
+		, const FVector& Entry
+		, const FVector& Exit
+		, FVector& OutAxis
+	)
+	{
+		const FVector ToEntry = Entry - Center;
+		const FVector ToExit = Exit - Center;
+		OutAxis = FVector::CrossProduct(ToEntry, Entry - Before).GetSafeNormal();
+		if (OutAxis.IsNearlyZero())
+		{
+			// Without an incoming direction the short arc is the best guess.
+			OutAxis = FVector::CrossProduct(ToEntry, ToExit).GetSafeNormal();
+			if (OutAxis.IsNearlyZero())
+			{
+				FVector Unused;
+				ToEntry.GetSafeNormal().FindBestAxisVectors(OutAxis, Unused);
+			}
+		}
+		const float Angle = FMath::Atan2(
+			FVector::DotProduct(FVector::CrossProduct(ToEntry, ToExit), OutAxis)
+			, FVector::DotProduct(ToEntry, ToExit)
+		);
+		if (Angle >= 0.f)
+		{
+			return Angle;
+		}
+		// Exits a hair behind the entry are the same point, not a full turn.
+		return -Angle * ToEntry.Size() <= TAUT_ROPE_DISTANCE_TOLERANCE ? 0.f : Angle + UE_TWO_PI;
+	}
+
+	float GetCurvedWrapLength(
+		const FTautRopeCollisionShape& Shape
+		, const FVector& Before
+		, const FVector& Entry
+		, const FVector& Exit
+	)
+	{
+		const FVector Center = GetCurvedWrapCenter(Shape, Entry, Exit);
+		FVector Axis;
+		const float Angle = GetCurvedWrapAngle(Center, Before, Entry, Exit, Axis);
+		return Angle * ((Entry - Center).Size() + (Exit - Center).Size()) * 0.5f;
+	}
+
+	void AppendCurvedWrapLocations(
+		const FTautRopeCollisionShape& Shape
+		, const FVector& Before
+		, const FVector& Entry
+		, const FVector& Exit
+		, TArray<FVector>& InOutLocations
+	)
+	{
+		const FVector Center = GetCurvedWrapCenter(Shape, Entry, Exit);
+		const FVector ToEntry = Entry - Center;
+		FVector Axis;
+		const float Angle = GetCurvedWrapAngle(Center, Before, Entry, Exit, Axis);
+		const int32 NumSteps = FMath::CeilToInt32(Angle / TAUT_ROPE_CURVED_ARC_STEP_RADIANS);
+		for (int32 Step = 1; Step < NumSteps; ++Step)
+		{
+			const float Alpha = static_cast<float>(Step) / NumSteps;
+			InOutLocations.Add(Center + FQuat(Axis, Angle * Alpha).RotateVector(ToEntry));
+		}
+	}
+}
\ No newline at end of file
@@ -14,57 +14,215 @@ namespace TautRope
         , FirstPointIndex(InFirstPointIndex)
     {}
 
-    TArray<FMovementGroup> GetMovementGroups(
-        const TArray<FPoint>& RopePoints,
-        const TArray<FTautRopeCollisionShape>& NearbyShapes
-    )
-    {
-        TArray<FMovementGroup> MovementGroups;
-        const int32 NumPoints = RopePoints.Num();
-        if (NumPoints < 3)
-        {
-            return MovementGroups;
-        }
+	// Edge points that can be part of a fan, curved contacts and vertex crossings are solved on their own.
+	static bool IsFanPoint(
+		const FPoint& Point
+		, const TArray<FTautRopeCollisionShape>& NearbyShapes
+	)
+	{
+		return Point.ShapeIndex != INDEX_NONE
+			&& Point.EdgeIndex != INDEX_NONE
+			&& Point.VertIndex == INDEX_NONE
+			&& !NearbyShapes[Point.ShapeIndex].IsCurved();
+	}
 
-        MovementGroups.Add(
-            FMovementGroup(RopePoints[1].ShapeIndex, RopePoints[1].VertIndex, 0)
-        );
+	TArray<FMovementGroup> GetMovementGroups(
+		const TArray<FPoint>& RopePoints
+		, const TArray<FTautRopeCollisionShape>& NearbyShapes
+	)
+	{
+		TArray<FMovementGroup> MovementGroups;
+		const int32 NumPoints = RopePoints.Num();
+		int32 i = 1;
+		while (i < NumPoints - 2)
+		{
+			const FPoint& Point = RopePoints[i];
+			const FPoint& NextPoint = RopePoints[i + 1];
+			if (!IsFanPoint(Point, NearbyShapes) || !IsFanPoint(NextPoint, NearbyShapes) || Point.ShapeIndex != NextPoint.ShapeIndex || Point.EdgeIndex == NextPoint.EdgeIndex)
+			{
+				++i;
+				continue;
+			}
+			const FTautRopeCollisionShape& Shape = NearbyShapes[Point.ShapeIndex];
+			const FIntVector2& Edge = Shape.GetGeometry().Edges[Point.EdgeIndex];
+			const TArray<int32> NextCandidateVerts = GetCandidateVerts(NextPoint, Shape);
+			const int32 SharedVertIndex = NextCandidateVerts.Contains(Edge.X)
+				? Edge.X
+				: NextCandidateVerts.Contains(Edge.Y) ? Edge.Y : INDEX_NONE;
+			if (SharedVertIndex == INDEX_NONE)
+			{
+				++i;
+				continue;
+			}
 
-        for (int32 i = 1; i < NumPoints - 1; i++)
-        {
-            const FPoint& Point = RopePoints[i];
-            FMovementGroup& CurrentGroup = MovementGroups.Last();
-            CurrentGroup.LastPointIndex = i;
-
-            const FTautRopeCollisionShape& Shape = NearbyShapes[Point.ShapeIndex];
-            const TArray<int32> CandidateVerts = GetCandidateVerts(Point, Shape);
-            const int32 GroupVertIndex = CurrentGroup.VertIndex;
-
-            const bool bBelongsInLastVertexGroup =
-                CurrentGroup.ShapeIndex == Point.ShapeIndex &&
-                CandidateVerts.Contains(GroupVertIndex) &&
-                !CurrentGroup.EdgeIndices.Contains(Point.EdgeIndex);
-
-            if (bBelongsInLastVertexGroup)
-            {
-                CurrentGroup.EdgeIndices.Add(Point.EdgeIndex);
-            }
-            else
-            {
-                MovementGroups.Add(
-                    FMovementGroup(Point.ShapeIndex, CandidateVerts[0], i)
-                );
-            }
-        }
+			FMovementGroup& Group = MovementGroups.Emplace_GetRef(Point.ShapeIndex, SharedVertIndex, i);
+			Group.EdgeIndices.Add(Point.EdgeIndex);
+			Group.LastPointIndex = i;
+			for (int32 j = i + 1; j < NumPoints - 1; ++j)
+			{
+				const FPoint& FanPoint = RopePoints[j];
+				const bool bBelongsInGroup = IsFanPoint(FanPoint, NearbyShapes)
+					&& FanPoint.ShapeIndex == Group.ShapeIndex
+					&& !Group.EdgeIndices.Contains(FanPoint.EdgeIndex)
+					&& GetCandidateVerts(FanPoint, Shape).Contains(SharedVertIndex);
+				if (!bBelongsInGroup)
+				{
+					break;
+				}
+				Group.EdgeIndices.Add(FanPoint.EdgeIndex);
+				Group.LastPointIndex = j;
+			}
+			i = Group.LastPointIndex + 1;
+		}
+		return MovementGroups;
+	}
 
-        if (!MovementGroups.IsEmpty())
-        {
-            MovementGroups[0].FirstPointIndex = 0;
-            MovementGroups.Last().LastPointIndex = NumPoints - 1;
-        }
+	bool SolveMovementGroup(
+		const FMovementGroup& Group
+		, const FTautRopeCollisionShape& Shape
+		, const FVector& A
+		, const FVector& C
+		, TArray<FVector>& InOutTargetLocations
+	)
+	{
+		auto AngleBetween = [](const FVector& U, const FVector& V)
+			{
+				return FMath::Acos(FMath::Clamp(FVector::DotProduct(U, V), -1.f, 1.f));
+			};
 
-        return MovementGroups;
-    }
+		const FVector VertexLocation = Shape.GetVertex(Group.VertIndex);
+		TArray<FVector, TInlineAllocator<8>> EdgeDirs;
+		TArray<float, TInlineAllocator<8>> EdgeLengths;
+		for (const int32 EdgeIndex : Group.EdgeIndices)
+		{
+			const FIntVector2& Edge = Shape.GetGeometry().Edges[EdgeIndex];
+			const FVector ToOtherEnd = Shape.GetVertex(Edge.X == Group.VertIndex ? Edge.Y : Edge.X) - VertexLocation;
+			EdgeLengths.Add(ToOtherEnd.Size());
+			EdgeDirs.Add(ToOtherEnd.GetSafeNormal());
+		}
+
+		// Unfold the faces between consecutive edges around the vertex into one plane, with the first edge along +X.
+		TArray<float, TInlineAllocator<8>> EdgeAngles;
+		EdgeAngles.Add(0.f);
+		for (int32 k = 1; k < EdgeDirs.Num(); ++k)
+		{
+			EdgeAngles.Add(EdgeAngles.Last() + AngleBetween(EdgeDirs[k - 1], EdgeDirs[k]));
+		}
+		const FVector ToA = A - VertexLocation;
+		const FVector ToC = C - VertexLocation;
+		const float AngleA = -AngleBetween(ToA.GetSafeNormal(), EdgeDirs[0]);
+		const float AngleC = EdgeAngles.Last() + AngleBetween(ToC.GetSafeNormal(), EdgeDirs.Last());
+		// Half a turn or more around the vertex and the rope slips over it rather than across the fan.
+		if (AngleC - AngleA >= UE_PI - KINDA_SMALL_NUMBER)
+		{
+			return false;
+		}
+
+		const FVector2D A2D = FVector2D(FMath::Cos(AngleA), FMath::Sin(AngleA)) * ToA.Size();
+		const FVector2D C2D = FVector2D(FMath::Cos(AngleC), FMath::Sin(AngleC)) * ToC.Size();
+		const FVector2D AC = C2D - A2D;
+		const float ACrossAC = FVector2D::CrossProduct(A2D, AC);
+		TArray<float, TInlineAllocator<8>> EdgeDistances;
+		for (int32 k = 0; k < EdgeDirs.Num(); ++k)
+		{
+			const FVector2D EdgeDir2D(FMath::Cos(EdgeAngles[k]), FMath::Sin(EdgeAngles[k]));
+			const float Denom = FVector2D::CrossProduct(EdgeDir2D, AC);
+			if (FMath::Abs(Denom) < KINDA_SMALL_NUMBER)
+			{
+				return false;
+			}
+			// Straight lines that leave an edge at either end cross a vertex, which the per point solve handles.
+			const float EdgeDistance = ACrossAC / Denom;
+			if (EdgeDistance < TAUT_ROPE_DISTANCE_TOLERANCE || EdgeDistance > EdgeLengths[k] - TAUT_ROPE_DISTANCE_TOLERANCE)
+			{
+				return false;
+			}
+			EdgeDistances.Add(EdgeDistance);
+		}
+		for (int32 k = 0; k < EdgeDirs.Num(); ++k)
+		{
+			InOutTargetLocations[Group.FirstPointIndex + k] = VertexLocation + EdgeDirs[k] * EdgeDistances[k];
+		}
+		return true;
+	}
+
+	TArray<FContactChain> GetContactChains(
+		const TArray<FPoint>& RopePoints
+		, const TArray<FTautRopeCollisionShape>& NearbyShapes
+	)
+	{
+		TArray<FContactChain> ContactChains;
+		const int32 NumPoints = RopePoints.Num();
+		int32 i = 1;
+		while (i < NumPoints - 1)
+		{
+			if (!IsFanPoint(RopePoints[i], NearbyShapes))
+			{
+				++i;
+				continue;
+			}
+			const int32 ShapeIndex = RopePoints[i].ShapeIndex;
+			int32 j = i + 1;
+			while (j < NumPoints - 1 && IsFanPoint(RopePoints[j], NearbyShapes) && RopePoints[j].ShapeIndex == ShapeIndex)
+			{
+				++j;
+			}
+			if (j - i > 1)
+			{
+				ContactChains.Add({ ShapeIndex, i, j - 1 });
+			}
+			i = j;
+		}
+		return ContactChains;
+	}
+
+	void SolveContactChain(
+		const FContactChain& Chain
+		, const TArray<FPoint>& RopePoints
+		, const FTautRopeCollisionShape& Shape
+		, TArray<FVector>& InOutTargetLocations
+	)
+	{
+		const int32 NumChainPoints = Chain.LastPointIndex - Chain.FirstPointIndex + 1;
+		TArray<FVector, TInlineAllocator<16>> EdgeVerts;
+		EdgeVerts.Reserve(NumChainPoints * 2);
+		for (int32 i = Chain.FirstPointIndex; i <= Chain.LastPointIndex; ++i)
+		{
+			const FIntVector2& Edge = Shape.GetGeometry().Edges[RopePoints[i].EdgeIndex];
+			EdgeVerts.Add(Shape.GetVertex(Edge.X));
+			EdgeVerts.Add(Shape.GetVertex(Edge.Y));
+		}
+
+		// The path length is convex in the points' distances along their edges, and each point's
+		// two-segment unfolding about its edge is its exact minimum, so alternating sweeps settle on the shortest path.
+		// Edges of a chain are usually skew, which rules out unfolding the whole chain into one plane.
+		for (int32 Sweep = 0; Sweep < TAUT_ROPE_MAX_CHAIN_TIGHTENING_ITERATIONS; ++Sweep)
+		{
+			const bool bIsForward = Sweep % 2 == 0;
+			float MaxMoveSquared = 0.f;
+			for (int32 k = 0; k < NumChainPoints; ++k)
+			{
+				const int32 ChainIndex = bIsForward ? k : NumChainPoints - 1 - k;
+				const int32 i = Chain.FirstPointIndex + ChainIndex;
+				float DistAlongEdge = 0.f;
+				float EdgeLength = 0.f;
+				const FVector Location = FindMinDistancePointBetweenABOnLineXY(
+					InOutTargetLocations[i - 1]
+					, InOutTargetLocations[i + 1]
+					, EdgeVerts[ChainIndex * 2]
+					, EdgeVerts[ChainIndex * 2 + 1]
+					, DistAlongEdge
+					, EdgeLength
+				);
+				MaxMoveSquared = FMath::Max(MaxMoveSquared, FVector::DistSquared(Location, InOutTargetLocations[i]));
+				InOutTargetLocations[i] = Location;
+			}
+			if (MaxMoveSquared < TAUT_ROPE_DISTANCE_TOLERANCE_SQUARED)
+			{
+				break;
+			}
+		}
+	}
 
     TArray<int32> GetCandidateVerts(const FPoint& Point, const FTautRopeCollisionShape& Shape)
     {
@@ -74,11 +232,26 @@ namespace TautRope
         }
         else
         {
-            const FIntVector2& Edge = Shape.Edges[Point.EdgeIndex];
+            const FIntVector2& Edge = Shape.GetGeometry().Edges[Point.EdgeIndex];
             return { Edge.X, Edge.Y };
         }
     }
 
+	FVector GetVertexCrossingLocation(
+		const FTautRopeCollisionShape& Shape
+		, const int32 EdgeIndex
+		, const int32 VertIndex
+	)
+	{
+		// Used to get a normalized vector inbetween two unit length orthogonal vectors.
+		constexpr float INV_SQRT2 = 0.70710678f;
+
+		const FQuat EdgeRotation = Shape.GetEdgeRotation(EdgeIndex);
+		const bool bIsEdgeStart = Shape.GetGeometry().Edges[EdgeIndex].X == VertIndex;
+		const FVector AlongEdge = bIsEdgeStart ? -EdgeRotation.GetForwardVector() : EdgeRotation.GetForwardVector();
+		return Shape.GetVertex(VertIndex) + (EdgeRotation.GetUpVector() + AlongEdge) * INV_SQRT2 * TAUT_ROPE_VERTEX_CROSSING_OFFSET;
+	}
+
 	FVector FindMinDistancePointBetweenABOnLineXY(
 		const FVector& A
 		, const FVector& B
@@ -19,7 +19,7 @@ namespace TautRope
 				continue;
 			}
 			const FTautRopeCollisionShape& Shape = NearbyShapes[PointAtVert.ShapeIndex];
-			const TArray<int32>& AdjacentEdges = Shape.VertToEdges[PointAtVert.VertIndex].Edges;
+			const TArray<int32>& AdjacentEdges = Shape.GetGeometry().VertToEdges[PointAtVert.VertIndex].Edges;
 
 			int32 GroupStart = i;
 			for (int32 j = i - 1; j >= 0; --j)
@@ -75,9 +75,10 @@ namespace TautRope
 			const FVector& LocationC = RopePoints[i + 1].Location;
 
 			const FTautRopeCollisionShape& Shape = NearbyShapes[PointB.ShapeIndex];
-			const FIntVector2& FromEdge = Shape.Edges[PointB.EdgeIndex];
-			const FVector& FromEdgeVertX = Shape.Vertices[FromEdge.X];
-			const FVector& FromEdgeVertY = Shape.Vertices[FromEdge.Y];
+			const FTautRopeCollisionShape& Geometry = Shape.GetGeometry();
+			const FIntVector2& FromEdge = Geometry.Edges[PointB.EdgeIndex];
+			const FVector FromEdgeVertX = Shape.GetVertex(FromEdge.X);
+			const FVector FromEdgeVertY = Shape.GetVertex(FromEdge.Y);
 			const FVector FromEdgeDirection = PointB.VertIndex == FromEdge.X
 				? (FromEdgeVertX - FromEdgeVertY).GetSafeNormal()
 				: (FromEdgeVertY - FromEdgeVertX).GetSafeNormal();
@@ -97,15 +98,14 @@ namespace TautRope
 			{
 				RopeSlidingDirection = -RopeUp;
 			}
-			const FVector& VertexLocation = Shape.Vertices[PointB.VertIndex];
+			const FVector VertexLocation = Shape.GetVertex(PointB.VertIndex);
 			int32 MostOffendingEdgeIndex = INDEX_NONE;
 			float MostOffendingEdgeDot = 0.f;
-			const TArray<int32>& AdjacentEdges = Shape.VertToEdges[PointB.VertIndex].Edges;
+			const TArray<int32>& AdjacentEdges = Geometry.VertToEdges[PointB.VertIndex].Edges;
 			for (const int32 AdjacentEdgeIndex : AdjacentEdges)
 			{
-				const FIntVector2& AdjacentEdge = Shape.Edges[AdjacentEdgeIndex];
-				const FVector& AdjacentEdgeVertA = Shape.Vertices[AdjacentEdge.X];
-				const FVector& OtherEndLocation = PointB.VertIndex == AdjacentEdge.X ? Shape.Vertices[AdjacentEdge.Y] : Shape.Vertices[AdjacentEdge.X];
+				const FIntVector2& AdjacentEdge = Geometry.Edges[AdjacentEdgeIndex];
+				const FVector OtherEndLocation = Shape.GetVertex(PointB.VertIndex == AdjacentEdge.X ? AdjacentEdge.Y : AdjacentEdge.X);
 				const FVector EdgeDir = OtherEndLocation - VertexLocation;
 				const float EdgeDot = FVector::DotProduct(EdgeDir, RopeSlidingDirection);
 				if (EdgeDot > MostOffendingEdgeDot)
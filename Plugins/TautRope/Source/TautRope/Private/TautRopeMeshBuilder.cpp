@@ -0,0 +1,224 @@
+#include "TautRopeMeshBuilder.h"
+#include "TautRopeConfig.h"
+
+namespace TautRope
+{
+	FMeshBuilder::FDirtyRange FMeshBuilder::Update(
+		const TConstArrayView<FVector> InPoints
+		, const FMeshSettings& InSettings
+	)
+	{
+		FMeshSettings NewSettings = InSettings;
+		NewSettings.Radius = FMath::Max(NewSettings.Radius, KINDA_SMALL_NUMBER);
+		NewSettings.NumSides = FMath::Max(NewSettings.NumSides, 3);
+		NewSettings.NumBendRings = FMath::Max(NewSettings.NumBendRings, 1);
+		const bool bIsSettingsChanged = !(NewSettings == Settings);
+		Settings = NewSettings;
+
+		FDirtyRange DirtyRange;
+		const int32 NumPoints = InPoints.Num();
+		const int32 NumPrevPoints = Points.Num();
+		if (NumPoints < 2)
+		{
+			Points.Reset();
+			RingCenters.Reset();
+			RingDirections.Reset();
+			RingRotations.Reset();
+			RingArcLengths.Reset();
+			Vertices.Reset();
+			Bounds = FBox(ForceInit);
+			return DirtyRange;
+		}
+
+		// Rope points in the unchanged head and tail keep their rings.
+		int32 NumSameHead = 0;
+		int32 NumSameTail = 0;
+		if (!bIsSettingsChanged)
+		{
+			const int32 MaxNumSame = FMath::Min(NumPoints, NumPrevPoints);
+			while (NumSameHead < MaxNumSame && InPoints[NumSameHead] == Points[NumSameHead])
+			{
+				++NumSameHead;
+			}
+			while (NumSameTail < MaxNumSame - NumSameHead && InPoints[NumPoints - 1 - NumSameTail] == Points[NumPrevPoints - 1 - NumSameTail])
+			{
+				++NumSameTail;
+			}
+			if (NumSameHead == NumPoints && NumPoints == NumPrevPoints)
+			{
+				return DirtyRange;
+			}
+		}
+
+		Points.Reset();
+		Points.Append(InPoints.GetData(), NumPoints);
+		Bounds = FBox(Points).ExpandBy(Settings.Radius);
+		const int32 NumRings = CalcNumRings(NumPoints);
+		const bool bHasPrevFirstRotation = RingRotations.Num() > 0;
+		const FQuat PrevFirstRotation = bHasPrevFirstRotation ? RingRotations[0] : FQuat::Identity;
+		RingCenters.SetNum(NumRings, EAllowShrinking::No);
+		RingDirections.SetNum(NumRings, EAllowShrinking::No);
+		RingRotations.SetNum(NumRings, EAllowShrinking::No);
+		RingArcLengths.SetNum(NumRings, EAllowShrinking::No);
+		Vertices.SetNum(NumRings * GetNumVerticesPerRing(), EAllowShrinking::No);
+
+		// A ring depends on its rope point's neighbours, and a changed number of points shifts every ring after the change.
+		const int32 FirstDirtyPointIndex = FMath::Max(NumSameHead - 1, 0);
+		const int32 LastDirtyPointIndex = NumPoints == NumPrevPoints
+			? FMath::Min(NumPoints - NumSameTail, NumPoints - 1)
+			: NumPoints - 1;
+		for (int32 PointIndex = FirstDirtyPointIndex; PointIndex <= LastDirtyPointIndex; ++PointIndex)
+		{
+			BuildPointRings(PointIndex);
+		}
+		const int32 FirstDirtyRingIndex = GetFirstRingIndex(FirstDirtyPointIndex);
+		const int32 EndDirtyRingIndex = GetFirstRingIndex(LastDirtyPointIndex) + GetNumPointRings(LastDirtyPointIndex);
+		for (int32 RingIndex = FirstDirtyRingIndex; RingIndex < EndDirtyRingIndex; ++RingIndex)
+		{
+			RingArcLengths[RingIndex] = RingIndex == 0
+				? 0.f
+				: RingArcLengths[RingIndex - 1] + FVector::Dist(RingCenters[RingIndex - 1], RingCenters[RingIndex]);
+			UpdateRingRotation(RingIndex, bHasPrevFirstRotation ? &PrevFirstRotation : nullptr);
+			BuildRingVertices(RingIndex);
+		}
+		DirtyRange.FirstVertex = FirstDirtyRingIndex * GetNumVerticesPerRing();
+		DirtyRange.EndVertex = EndDirtyRingIndex * GetNumVerticesPerRing();
+
+		// The clean tail only needs its texture coordinates shifted when the rebuilt span changed length.
+		if (EndDirtyRingIndex < NumRings)
+		{
+			const float TailArcLength = RingArcLengths[EndDirtyRingIndex - 1] + FVector::Dist(RingCenters[EndDirtyRingIndex - 1], RingCenters[EndDirtyRingIndex]);
+			const float ArcLengthDelta = TailArcLength - RingArcLengths[EndDirtyRingIndex];
+			if (!FMath::IsNearlyZero(ArcLengthDelta))
+			{
+				const float DeltaV = ArcLengthDelta / (UE_TWO_PI * Settings.Radius);
+				for (int32 RingIndex = EndDirtyRingIndex; RingIndex < NumRings; ++RingIndex)
+				{
+					RingArcLengths[RingIndex] += ArcLengthDelta;
+				}
+				for (int32 VertexIndex = DirtyRange.EndVertex; VertexIndex < Vertices.Num(); ++VertexIndex)
+				{
+					Vertices[VertexIndex].TextureCoordinate[0].Y += DeltaV;
+				}
+				DirtyRange.EndVertex = Vertices.Num();
+			}
+		}
+
+		// Ring rotations are carried from ring to ring, so the clean tail follows the rebuilt span until a ring keeps its rotation.
+		for (int32 RingIndex = EndDirtyRingIndex; RingIndex < NumRings; ++RingIndex)
+		{
+			const FQuat PrevRotation = RingRotations[RingIndex];
+			UpdateRingRotation(RingIndex, nullptr);
+			if (RingRotations[RingIndex].Equals(PrevRotation, TAUT_ROPE_MESH_RING_ROTATION_TOLERANCE))
+			{
+				RingRotations[RingIndex] = PrevRotation;
+				break;
+			}
+			BuildRingVertices(RingIndex);
+			DirtyRange.EndVertex = FMath::Max(DirtyRange.EndVertex, (RingIndex + 1) * GetNumVerticesPerRing());
+		}
+		return DirtyRange;
+	}
+
+	void FMeshBuilder::BuildIndices(
+		const int32 NumRings
+		, TArray<uint32>& OutIndices
+	) const
+	{
+		const uint32 NumVerticesPerRing = GetNumVerticesPerRing();
+		OutIndices.Reset(FMath::Max(NumRings - 1, 0) * Settings.NumSides * 6);
+		for (int32 RingIndex = 0; RingIndex < NumRings - 1; ++RingIndex)
+		{
+			for (int32 Side = 0; Side < Settings.NumSides; ++Side)
+			{
+				const uint32 A = RingIndex * NumVerticesPerRing + Side;
+				const uint32 B = A + 1;
+				const uint32 C = A + NumVerticesPerRing;
+				const uint32 D = C + 1;
+				OutIndices.Append({ A, B, C, B, D, C });
+			}
+		}
+	}
+
+	int32 FMeshBuilder::GetFirstRingIndex(const int32 PointIndex) const
+	{
+		return PointIndex == 0 ? 0 : 1 + (PointIndex - 1) * Settings.NumBendRings;
+	}
+
+	int32 FMeshBuilder::CalcNumRings(const int32 NumPoints) const
+	{
+		return 2 + (NumPoints - 2) * Settings.NumBendRings;
+	}
+
+	int32 FMeshBuilder::GetNumPointRings(const int32 PointIndex) const
+	{
+		return PointIndex == 0 || PointIndex == Points.Num() - 1 ? 1 : Settings.NumBendRings;
+	}
+
+	void FMeshBuilder::BuildPointRings(const int32 PointIndex)
+	{
+		const int32 FirstRingIndex = GetFirstRingIndex(PointIndex);
+		const FVector& Point = Points[PointIndex];
+		if (PointIndex == 0 || PointIndex == Points.Num() - 1)
+		{
+			const FVector Direction = PointIndex == 0 ? Points[1] - Point : Point - Points[PointIndex - 1];
+			RingCenters[FirstRingIndex] = Point;
+			RingDirections[FirstRingIndex] = Direction.GetSafeNormal(UE_SMALL_NUMBER, FVector::ForwardVector);
+			return;
+		}
+
+		const FVector ToPrev = Points[PointIndex - 1] - Point;
+		const FVector ToNext = Points[PointIndex + 1] - Point;
+		const FVector FallbackDirection = (-ToPrev).GetSafeNormal(UE_SMALL_NUMBER, FVector::ForwardVector);
+		const float BendDistance = FMath::Min3(Settings.BendDistance, ToPrev.Size() * 0.5f, ToNext.Size() * 0.5f);
+		const FVector BendStart = Point + ToPrev.GetSafeNormal() * BendDistance;
+		const FVector BendEnd = Point + ToNext.GetSafeNormal() * BendDistance;
+		for (int32 BendRingIndex = 0; BendRingIndex < Settings.NumBendRings; ++BendRingIndex)
+		{
+			// Quadratic bezier from the bend start to the bend end, pulled toward the rope point.
+			const float Alpha = Settings.NumBendRings == 1 ? 0.5f : static_cast<float>(BendRingIndex) / (Settings.NumBendRings - 1);
+			const int32 RingIndex = FirstRingIndex + BendRingIndex;
+			RingCenters[RingIndex] = FMath::Lerp(FMath::Lerp(BendStart, Point, Alpha), FMath::Lerp(Point, BendEnd, Alpha), Alpha);
+			RingDirections[RingIndex] = FMath::Lerp(Point - BendStart, BendEnd - Point, Alpha).GetSafeNormal(UE_SMALL_NUMBER, FallbackDirection);
+		}
+	}
+
+	void FMeshBuilder::UpdateRingRotation(
+		const int32 RingIndex
+		, const FQuat* PrevFirstRotation
+	)
+	{
+		const FVector& Direction = RingDirections[RingIndex];
+		if (RingIndex > 0)
+		{
+			// Turning the previous ring by the smallest rotation onto this direction keeps the tube from twisting at any heading.
+			RingRotations[RingIndex] = (FQuat::FindBetweenNormals(RingDirections[RingIndex - 1], Direction) * RingRotations[RingIndex - 1]).GetNormalized();
+			return;
+		}
+		// The first ring follows its own rotation from the last update, so the whole tube keeps its twist over time.
+		RingRotations[0] = PrevFirstRotation != nullptr
+			? (FQuat::FindBetweenNormals(PrevFirstRotation->GetAxisX(), Direction) * *PrevFirstRotation).GetNormalized()
+			: FRotationMatrix::MakeFromX(Direction).ToQuat();
+	}
+
+	void FMeshBuilder::BuildRingVertices(const int32 RingIndex)
+	{
+		const FQuat& Rotation = RingRotations[RingIndex];
+		const FVector3f TangentX(RingDirections[RingIndex]);
+		const float V = RingArcLengths[RingIndex] / (UE_TWO_PI * Settings.Radius);
+		const int32 FirstVertexIndex = RingIndex * GetNumVerticesPerRing();
+		for (int32 Side = 0; Side <= Settings.NumSides; ++Side)
+		{
+			const float U = static_cast<float>(Side) / Settings.NumSides;
+			const float Angle = UE_TWO_PI * U;
+			const FVector Normal = Rotation.RotateVector(FVector(0.f, FMath::Cos(Angle), FMath::Sin(Angle)));
+			Vertices[FirstVertexIndex + Side] = FDynamicMeshVertex(
+				FVector3f(RingCenters[RingIndex] + Normal * Settings.Radius)
+				, TangentX
+				, FVector3f(Normal)
+				, FVector2f(U, V)
+				, FColor::White
+			);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,248 @@
+#include "TautRopeMeshComponent.h"
+
+#include "Engine/CollisionProfile.h"
+#include "LocalVertexFactory.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialRenderProxy.h"
+#include "PrimitiveSceneProxy.h"
+#include "RenderingThread.h"
+#include "SceneInterface.h"
+#include "StaticMeshResources.h"
+
+class FTautRopeMeshSceneProxy final : public FPrimitiveSceneProxy
+{
+public:
+	FTautRopeMeshSceneProxy(
+		const UTautRopeMeshComponent* Component
+		, const TautRope::FMeshBuilder& MeshBuilder
+		, const int32 InRingCapacity
+	)
+		: FPrimitiveSceneProxy(Component)
+		, VertexFactory(GetScene().GetFeatureLevel(), "FTautRopeMeshSceneProxy")
+		, MaterialRelevance(Component->GetMaterialRelevance(GetScene().GetShaderPlatform()))
+		, NumRings(MeshBuilder.GetNumRings())
+		, NumVerticesPerRing(MeshBuilder.GetNumVerticesPerRing())
+	{
+		// Buffers are sized for the capacity up front, so rope points can be added without reallocating them.
+		TArray<FDynamicMeshVertex> Vertices = MeshBuilder.GetVertices();
+		Vertices.SetNum(InRingCapacity * NumVerticesPerRing);
+		VertexBuffers.InitFromDynamicVertex(&VertexFactory, Vertices);
+		MeshBuilder.BuildIndices(InRingCapacity, IndexBuffer.Indices);
+		BeginInitResource(&IndexBuffer);
+
+		Material = Component->GetMaterial(0);
+		if (Material == nullptr)
+		{
+			Material = UMaterial::GetDefaultMaterial(MD_Surface);
+		}
+	}
+
+	virtual ~FTautRopeMeshSceneProxy()
+	{
+		VertexBuffers.PositionVertexBuffer.ReleaseResource();
+		VertexBuffers.StaticMeshVertexBuffer.ReleaseResource();
+		VertexBuffers.ColorVertexBuffer.ReleaseResource();
+		IndexBuffer.ReleaseResource();
+		VertexFactory.ReleaseResource();
+	}
+
+	virtual SIZE_T GetTypeHash() const override
+	{
+		static size_t UniquePointer;
+		return reinterpret_cast<size_t>(&UniquePointer);
+	}
+
+	void UpdateVertices_RenderThread(
+		FRHICommandListBase& RHICmdList
+		, const int32 FirstVertex
+		, const TArray<FDynamicMeshVertex>& Vertices
+		, const int32 InNumRings
+	)
+	{
+		NumRings = InNumRings;
+		if (Vertices.IsEmpty())
+		{
+			return;
+		}
+		FPositionVertexBuffer& PositionBuffer = VertexBuffers.PositionVertexBuffer;
+		FStaticMeshVertexBuffer& StaticMeshBuffer = VertexBuffers.StaticMeshVertexBuffer;
+		for (int32 i = 0; i < Vertices.Num(); ++i)
+		{
+			const FDynamicMeshVertex& Vertex = Vertices[i];
+			const int32 VertexIndex = FirstVertex + i;
+			PositionBuffer.VertexPosition(VertexIndex) = Vertex.Position;
+			StaticMeshBuffer.SetVertexTangents(VertexIndex, Vertex.TangentX.ToFVector3f(), Vertex.GetTangentY(), Vertex.TangentZ.ToFVector3f());
+			StaticMeshBuffer.SetVertexUV(VertexIndex, 0, Vertex.TextureCoordinate[0]);
+		}
+
+		// Only the changed range of each buffer is locked and copied.
+		auto UploadRange = [&RHICmdList, FirstVertex, NumVertices = Vertices.Num()](FRHIBuffer* Buffer, const void* Data, const uint32 Stride)
+			{
+				void* BufferData = RHICmdList.LockBuffer(Buffer, FirstVertex * Stride, NumVertices * Stride, RLM_WriteOnly);
+				FMemory::Memcpy(BufferData, static_cast<const uint8*>(Data) + FirstVertex * Stride, NumVertices * Stride);
+				RHICmdList.UnlockBuffer(Buffer);
+			};
+		const uint32 NumBufferVertices = StaticMeshBuffer.GetNumVertices();
+		UploadRange(PositionBuffer.VertexBufferRHI, PositionBuffer.GetVertexData(), PositionBuffer.GetStride());
+		UploadRange(StaticMeshBuffer.TangentsVertexBuffer.VertexBufferRHI, StaticMeshBuffer.GetTangentData(), StaticMeshBuffer.GetTangentSize() / NumBufferVertices);
+		UploadRange(StaticMeshBuffer.TexCoordVertexBuffer.VertexBufferRHI, StaticMeshBuffer.GetTexCoordData(), StaticMeshBuffer.GetTexCoordSize() / NumBufferVertices);
+	}
+
+	virtual void GetDynamicMeshElements(
+		const TArray<const FSceneView*>& Views
+		, const FSceneViewFamily& ViewFamily
+		, uint32 VisibilityMap
+		, FMeshElementCollector& Collector
+	) const override
+	{
+		if (NumRings < 2)
+		{
+			return;
+		}
+		const FMaterialRenderProxy* MaterialProxy = Material->GetRenderProxy();
+		for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ++ViewIndex)
+		{
+			if ((VisibilityMap & (1 << ViewIndex)) == 0)
+			{
+				continue;
+			}
+			FMeshBatch& Mesh = Collector.AllocateMesh();
+			Mesh.VertexFactory = &VertexFactory;
+			Mesh.MaterialRenderProxy = MaterialProxy;
+			Mesh.ReverseCulling = IsLocalToWorldDeterminantNegative();
+			Mesh.Type = PT_TriangleList;
+			Mesh.DepthPriorityGroup = SDPG_World;
+			Mesh.bCanApplyViewModeOverrides = false;
+			FMeshBatchElement& BatchElement = Mesh.Elements[0];
+			BatchElement.IndexBuffer = &IndexBuffer;
+			BatchElement.PrimitiveUniformBuffer = GetUniformBuffer();
+			// Only the rings in use are drawn, the rest of the buffers is spare capacity.
+			BatchElement.FirstIndex = 0;
+			BatchElement.NumPrimitives = (NumRings - 1) * (NumVerticesPerRing - 1) * 2;
+			BatchElement.MinVertexIndex = 0;
+			BatchElement.MaxVertexIndex = NumRings * NumVerticesPerRing - 1;
+			Collector.AddMesh(ViewIndex, Mesh);
+		}
+	}
+
+	virtual FPrimitiveViewRelevance GetViewRelevance(const FSceneView* View) const override
+	{
+		FPrimitiveViewRelevance Result;
+		Result.bDrawRelevance = IsShown(View);
+		Result.bShadowRelevance = IsShadowCast(View);
+		Result.bDynamicRelevance = true;
+		MaterialRelevance.SetPrimitiveViewRelevance(Result);
+		return Result;
+	}
+
+	virtual uint32 GetMemoryFootprint() const override
+	{
+		return sizeof(*this) + GetAllocatedSize();
+	}
+
+private:
+	UMaterialInterface* Material = nullptr;
+	FStaticMeshVertexBuffers VertexBuffers;
+	FDynamicMeshIndexBuffer32 IndexBuffer;
+	FLocalVertexFactory VertexFactory;
+	FMaterialRelevance MaterialRelevance;
+	int32 NumRings = 0;
+	int32 NumVerticesPerRing = 0;
+};
+
+UTautRopeMeshComponent::UTautRopeMeshComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
+	SetGenerateOverlapEvents(false);
+	// The tube is built from world space rope points.
+	SetUsingAbsoluteLocation(true);
+	SetUsingAbsoluteRotation(true);
+	SetUsingAbsoluteScale(true);
+}
+
+void UTautRopeMeshComponent::SetRopePoints(const TArray<FVector>& Points)
+{
+	TautRope::FMeshSettings Settings;
+	Settings.Radius = Radius;
+	Settings.NumSides = NumSides;
+	Settings.NumBendRings = NumBendRings;
+	Settings.BendDistance = BendDistance;
+	const int32 PrevNumVerticesPerRing = MeshBuilder.GetNumVerticesPerRing();
+	const TautRope::FMeshBuilder::FDirtyRange DirtyRange = MeshBuilder.Update(Points, Settings);
+	if (MeshBuilder.GetNumRings() < 2)
+	{
+		if (SceneProxy != nullptr)
+		{
+			MarkRenderStateDirty();
+		}
+		return;
+	}
+	if (DirtyRange.IsEmpty())
+	{
+		return;
+	}
+	UpdateBounds();
+	MarkRenderTransformDirty();
+
+	if (MeshBuilder.GetNumRings() > ProxyRingCapacity || MeshBuilder.GetNumVerticesPerRing() != PrevNumVerticesPerRing)
+	{
+		MarkRenderStateDirty();
+		return;
+	}
+	if (PendingDirtyRange.IsEmpty())
+	{
+		PendingDirtyRange = DirtyRange;
+	}
+	else
+	{
+		PendingDirtyRange.FirstVertex = FMath::Min(PendingDirtyRange.FirstVertex, DirtyRange.FirstVertex);
+		PendingDirtyRange.EndVertex = FMath::Max(PendingDirtyRange.EndVertex, DirtyRange.EndVertex);
+	}
+	MarkRenderDynamicDataDirty();
+}
+
+FPrimitiveSceneProxy* UTautRopeMeshComponent::CreateSceneProxy()
+{
+	if (MeshBuilder.GetNumRings() < 2)
+	{
+		ProxyRingCapacity = 0;
+		return nullptr;
+	}
+	// Doubling the capacity keeps reallocations rare while contacts are added to the rope.
+	ProxyRingCapacity = static_cast<int32>(FMath::RoundUpToPowerOfTwo(static_cast<uint32>(FMath::Max(MeshBuilder.GetNumRings(), 16))));
+	PendingDirtyRange = TautRope::FMeshBuilder::FDirtyRange();
+	return new FTautRopeMeshSceneProxy(this, MeshBuilder, ProxyRingCapacity);
+}
+
+FBoxSphereBounds UTautRopeMeshComponent::CalcBounds(const FTransform& LocalToWorld) const
+{
+	const FBox& Bounds = MeshBuilder.GetBounds();
+	if (!Bounds.IsValid)
+	{
+		return FBoxSphereBounds(LocalToWorld.GetLocation(), FVector::ZeroVector, 0.f);
+	}
+	return FBoxSphereBounds(Bounds).TransformBy(LocalToWorld);
+}
+
+void UTautRopeMeshComponent::SendRenderDynamicData_Concurrent()
+{
+	Super::SendRenderDynamicData_Concurrent();
+
+	if (SceneProxy == nullptr || PendingDirtyRange.IsEmpty())
+	{
+		return;
+	}
+	FTautRopeMeshSceneProxy* Proxy = static_cast<FTautRopeMeshSceneProxy*>(SceneProxy);
+	const TArray<FDynamicMeshVertex>& Vertices = MeshBuilder.GetVertices();
+	// The rope may have lost points since the range was first marked.
+	const int32 FirstVertex = FMath::Min(PendingDirtyRange.FirstVertex, Vertices.Num());
+	const int32 EndVertex = FMath::Min(PendingDirtyRange.EndVertex, Vertices.Num());
+	PendingDirtyRange = TautRope::FMeshBuilder::FDirtyRange();
+	TArray<FDynamicMeshVertex> DirtyVertices(Vertices.GetData() + FirstVertex, EndVertex - FirstVertex);
+	ENQUEUE_RENDER_COMMAND(UpdateTautRopeMesh)(
+		[Proxy, FirstVertex, DirtyVertices = MoveTemp(DirtyVertices), NumRings = MeshBuilder.GetNumRings()](FRHICommandListImmediate& RHICmdList)
+		{
+			Proxy->UpdateVertices_RenderThread(RHICmdList, FirstVertex, DirtyVertices, NumRings);
+		});
+}
\ No newline at end of file
@@ -0,0 +1,177 @@
+#include "TautRopePackedPoint.h"
+#include "TautRopeHelpersMovement.h"
+
+namespace TautRope
+{
+	static uint32 QuantizeUnit(const float Value)
+	{
+		return static_cast<uint32>(FMath::RoundToInt32((FMath::Clamp(Value, -1.f, 1.f) * 0.5f + 0.5f) * MAX_uint16));
+	}
+
+	static float DequantizeUnit(const uint32 Value)
+	{
+		return static_cast<float>(Value) / MAX_uint16 * 2.f - 1.f;
+	}
+
+	static uint32 EncodeOctahedral(const FVector& Direction)
+	{
+		const FVector N = Direction / (FMath::Abs(Direction.X) + FMath::Abs(Direction.Y) + FMath::Abs(Direction.Z));
+		FVector2D Octahedral(N.X, N.Y);
+		if (N.Z < 0.)
+		{
+			Octahedral = FVector2D(
+				(1. - FMath::Abs(N.Y)) * (N.X >= 0. ? 1. : -1.)
+				, (1. - FMath::Abs(N.X)) * (N.Y >= 0. ? 1. : -1.)
+			);
+		}
+		return (QuantizeUnit(Octahedral.X) << 16) | QuantizeUnit(Octahedral.Y);
+	}
+
+	static FVector DecodeOctahedral(const uint32 Encoded)
+	{
+		FVector N(DequantizeUnit(Encoded >> 16), DequantizeUnit(Encoded & MAX_uint16), 0.);
+		N.Z = 1. - FMath::Abs(N.X) - FMath::Abs(N.Y);
+		const double Fold = FMath::Max(-N.Z, 0.);
+		N.X += N.X >= 0. ? -Fold : Fold;
+		N.Y += N.Y >= 0. ? -Fold : Fold;
+		return N.GetSafeNormal(UE_SMALL_NUMBER, FVector::UpVector);
+	}
+
+	FPackedPoint PackPoint(
+		const FPoint& Point
+		, const TArray<FTautRopeCollisionShape>& Shapes
+	)
+	{
+		FPackedPoint Packed;
+		Packed.ShapeIndex = Point.ShapeIndex;
+		const FTautRopeCollisionShape& Shape = Shapes[Point.ShapeIndex];
+		if (Point.EdgeIndex == INDEX_NONE)
+		{
+			// Curved contacts lie on the surface, so the closest axis point and the direction from it are enough.
+			const FVector LocalLocation = Shape.Transform.InverseTransformPositionNoScale(Point.Location);
+			const double AxisZ = FMath::Clamp(LocalLocation.Z, -static_cast<double>(Shape.HalfLength), static_cast<double>(Shape.HalfLength));
+			const float AxisAlpha = Shape.HalfLength > KINDA_SMALL_NUMBER ? AxisZ / Shape.HalfLength : 0.f;
+			Packed.FeatureBits = FPackedPoint::CurvedBit | QuantizeUnit(AxisAlpha);
+			Packed.Param = EncodeOctahedral((LocalLocation - FVector(0., 0., AxisZ)).GetSafeNormal(UE_SMALL_NUMBER, FVector::UpVector));
+			return Packed;
+		}
+		Packed.FeatureBits = static_cast<uint32>(Point.EdgeIndex) << 1;
+		const FIntVector2& Edge = Shape.GetGeometry().Edges[Point.EdgeIndex];
+		if (Point.VertIndex != INDEX_NONE)
+		{
+			Packed.FeatureBits |= FPackedPoint::VertexCrossingBit;
+			Packed.Param = Point.VertIndex == Edge.X ? 0 : MAX_uint32;
+			return Packed;
+		}
+		const FVector EdgeStart = Shape.GetVertex(Edge.X);
+		const FVector EdgeVector = Shape.GetVertex(Edge.Y) - EdgeStart;
+		const double EdgeAlpha = FMath::Clamp(FVector::DotProduct(Point.Location - EdgeStart, EdgeVector) / FMath::Max(EdgeVector.SizeSquared(), UE_SMALL_NUMBER), 0., 1.);
+		Packed.Param = static_cast<uint32>(FMath::RoundToDouble(EdgeAlpha * MAX_uint32));
+		return Packed;
+	}
+
+	FPoint UnpackPoint(
+		const FPackedPoint& Packed
+		, const TArray<FTautRopeCollisionShape>& Shapes
+	)
+	{
+		FPoint Point;
+		if (!Shapes.IsValidIndex(Packed.ShapeIndex))
+		{
+			return Point;
+		}
+		const FTautRopeCollisionShape& Shape = Shapes[Packed.ShapeIndex];
+		if (Packed.IsCurved())
+		{
+			if (Shape.IsCurved())
+			{
+				const double AxisZ = DequantizeUnit(Packed.FeatureBits & MAX_uint16) * Shape.HalfLength;
+				const FVector LocalLocation = FVector(0., 0., AxisZ) + DecodeOctahedral(Packed.Param) * Shape.Radius;
+				Point.ShapeIndex = Packed.ShapeIndex;
+				Point.Location = Shape.Transform.TransformPositionNoScale(LocalLocation);
+			}
+			return Point;
+		}
+		const int32 EdgeIndex = Packed.GetEdgeIndex();
+		if (!Shape.GetGeometry().Edges.IsValidIndex(EdgeIndex))
+		{
+			return Point;
+		}
+		Point.ShapeIndex = Packed.ShapeIndex;
+		Point.EdgeIndex = EdgeIndex;
+		const FIntVector2& Edge = Shape.GetGeometry().Edges[EdgeIndex];
+		if (Packed.IsVertexCrossing())
+		{
+			Point.VertIndex = Packed.Param == 0 ? Edge.X : Edge.Y;
+			Point.Location = GetVertexCrossingLocation(Shape, EdgeIndex, Point.VertIndex);
+		}
+		else
+		{
+			Point.Location = FMath::Lerp(Shape.GetVertex(Edge.X), Shape.GetVertex(Edge.Y), static_cast<double>(Packed.Param) / MAX_uint32);
+		}
+		return Point;
+	}
+
+	FPackedRopeState PackRopePoints(
+		const TArray<FPoint>& RopePoints
+		, const TArray<FTautRopeCollisionShape>& Shapes
+	)
+	{
+		FPackedRopeState State;
+		if (RopePoints.Num() < 2)
+		{
+			return State;
+		}
+		State.StartLocation = RopePoints[0].Location;
+		State.EndLocation = RopePoints.Last().Location;
+		State.Points.Reserve(RopePoints.Num() - 2);
+		for (int32 i = 1; i < RopePoints.Num() - 1; ++i)
+		{
+			// Contacts with other ropes are found again from where those ropes are.
+			if (!Shapes[RopePoints[i].ShapeIndex].bIsTransient)
+			{
+				State.Points.Add(PackPoint(RopePoints[i], Shapes));
+			}
+		}
+		return State;
+	}
+
+	TArray<FPoint> UnpackRopePoints(
+		const FPackedRopeState& State
+		, const TArray<FTautRopeCollisionShape>& Shapes
+	)
+	{
+		TArray<FPoint> RopePoints;
+		RopePoints.Reserve(State.Points.Num() + 2);
+		RopePoints.Add(FPoint(State.StartLocation));
+		for (const FPackedPoint& Packed : State.Points)
+		{
+			const FPoint Point = UnpackPoint(Packed, Shapes);
+			if (Point.ShapeIndex != INDEX_NONE)
+			{
+				RopePoints.Add(Point);
+			}
+		}
+		RopePoints.Add(FPoint(State.EndLocation));
+		return RopePoints;
+	}
+
+	void GetPackedRopeLocations(
+		const FPackedRopeState& State
+		, const TArray<FTautRopeCollisionShape>& Shapes
+		, TArray<FVector>& OutLocations
+	)
+	{
+		OutLocations.Reset(State.Points.Num() + 2);
+		OutLocations.Add(State.StartLocation);
+		for (const FPackedPoint& Packed : State.Points)
+		{
+			const FPoint Point = UnpackPoint(Packed, Shapes);
+			if (Point.ShapeIndex != INDEX_NONE)
+			{
+				OutLocations.Add(Point.Location);
+			}
+		}
+		OutLocations.Add(State.EndLocation);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,326 @@
+#include "TautRopeRecording.h"
+#include "TautRope.h"
+#include "TautRopeModule.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace TautRope
+{
+	static constexpr uint32 RecordingMagic = 0x54525243; // 'TRRC'
+	static constexpr int32 RecordingVersion = 6;
+
+	void FRecording::Serialize(FArchive& Ar)
+	{
+		uint32 Magic = RecordingMagic;
+		int32 Version = RecordingVersion;
+		Ar << Magic;
+		Ar << Version;
+		if (Ar.IsLoading() && (Magic != RecordingMagic || Version != RecordingVersion))
+		{
+			Ar.SetError();
+			return;
+		}
+		Ar << Shapes;
+		Ar << InitialForeignSegments;
+		Ar << InitialRopePoints;
+		Ar << Frames;
+	}
+
+	bool FRecording::SaveToFile(const FString& FilePath) const
+	{
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes);
+		const_cast<FRecording*>(this)->Serialize(Writer);
+		return FFileHelper::SaveArrayToFile(Bytes, *FilePath);
+	}
+
+	bool FRecording::LoadFromFile(const FString& FilePath)
+	{
+		TArray<uint8> Bytes;
+		if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
+		{
+			return false;
+		}
+		FMemoryReader Reader(Bytes);
+		Serialize(Reader);
+		return !Reader.IsError();
+	}
+
+	void ReplayRecording(
+		const FRecording& Recording
+		, TArray<FReplayFrameResult>& OutFrameResults
+	)
+	{
+		FTautRope Rope;
+		Rope.AppendToNearbyShapes(Recording.Shapes);
+		Rope.SetForeignRopeSegments(Recording.InitialForeignSegments);
+		Rope.ResetRopePoints(Recording.InitialRopePoints, Recording.Frames.IsEmpty() ? 0.f : Recording.Frames[0].MaxLength);
+
+		OutFrameResults.Reset(Recording.Frames.Num());
+		for (const FRecordingFrame& Frame : Recording.Frames)
+		{
+			// Targets stay with the rope's shapes, so only the moved ones are set.
+			for (int32 i = 0; i < Frame.ShapeTransformIndices.Num(); ++i)
+			{
+				Rope.SetShapeTargetTransform(Frame.ShapeTransformIndices[i], Frame.ShapeTransforms[i]);
+			}
+			Rope.SetForeignRopeSegments(Frame.ForeignSegments);
+			const double FrameStartSeconds = FPlatformTime::Seconds();
+			Rope.UpdateRope(
+				Frame.StartLocation
+				, Frame.EndLocation
+				, Frame.MaxLength
+#if TAUT_ROPE_DEBUG_DRAWING
+				, nullptr
+#endif // TAUT_ROPE_DEBUG_DRAWING
+			);
+			FReplayFrameResult& Result = OutFrameResults.AddDefaulted_GetRef();
+			Result.Ms = (FPlatformTime::Seconds() - FrameStartSeconds) * 1000.0;
+			Result.NumRopePoints = Rope.GetNumRopePoints();
+		}
+	}
+
+	void LogReplayResults(
+		const FString& Name
+		, const FRecording& Recording
+		, const TArray<FReplayFrameResult>& FrameResults
+	)
+	{
+		if (FrameResults.IsEmpty())
+		{
+			UE_LOG(LogTautRope, Display, TEXT("Replay %s: no frames"), *Name);
+			return;
+		}
+		TArray<double> SortedMs;
+		SortedMs.Reserve(FrameResults.Num());
+		double TotalMs = 0.0;
+		for (int32 FrameIndex = 0; FrameIndex < FrameResults.Num(); ++FrameIndex)
+		{
+			const FReplayFrameResult& Result = FrameResults[FrameIndex];
+			const float RecordedMs = Recording.Frames.IsValidIndex(FrameIndex) ? Recording.Frames[FrameIndex].RecordedMs : 0.f;
+			UE_LOG(LogTautRope, Display, TEXT("Frame %5d: %8.3f ms (recorded %8.3f ms), %d points"), FrameIndex, Result.Ms, RecordedMs, Result.NumRopePoints);
+			TotalMs += Result.Ms;
+			SortedMs.Add(Result.Ms);
+		}
+		SortedMs.Sort();
+		const double P95Ms = SortedMs[FMath::Min(SortedMs.Num() - 1, FMath::FloorToInt32(SortedMs.Num() * 0.95))];
+		UE_LOG(LogTautRope, Display, TEXT("Replay %s: %d frames, total %.3f ms, avg %.3f ms, p95 %.3f ms, max %.3f ms")
+			, *Name
+			, FrameResults.Num()
+			, TotalMs
+			, TotalMs / FrameResults.Num()
+			, P95Ms
+			, SortedMs.Last()
+		);
+	}
+
+	bool SaveReplayResultsCsv(
+		const FString& FilePath
+		, const FRecording& Recording
+		, const TArray<FReplayFrameResult>& FrameResults
+	)
+	{
+		FString Csv = TEXT("Frame,ReplayMs,RecordedMs,NumRopePoints\n");
+		for (int32 FrameIndex = 0; FrameIndex < FrameResults.Num(); ++FrameIndex)
+		{
+			const float RecordedMs = Recording.Frames.IsValidIndex(FrameIndex) ? Recording.Frames[FrameIndex].RecordedMs : 0.f;
+			Csv += FString::Printf(TEXT("%d,%.4f,%.4f,%d\n"), FrameIndex, FrameResults[FrameIndex].Ms, RecordedMs, FrameResults[FrameIndex].NumRopePoints);
+		}
+		return FFileHelper::SaveStringToFile(Csv, *FilePath);
+	}
+
+	FRecording MakeFrameRepro(
+		const TArray<FTautRopeCollisionShape>& Shapes
+		, const TArray<FPoint>& RopePoints
+		, const FRecordingFrame& Frame
+	)
+	{
+		// Among static shapes every rope location of the update stays within the bounds of its input points and targets.
+		FBox UpdateBounds(ForceInit);
+		for (const FPoint& Point : RopePoints)
+		{
+			UpdateBounds += Point.Location;
+		}
+		UpdateBounds += Frame.StartLocation;
+		UpdateBounds += Frame.EndLocation;
+		UpdateBounds = UpdateBounds.ExpandBy(TAUT_ROPE_DISTANCE_TOLERANCE);
+
+		// A moving shape carries the rope wherever its frame sweeps. Its origin blends along a line to the target and its
+		// geometry stays within its radius around the origin, whichever way it turns.
+		TArray<const FTransform*> TargetTransforms;
+		TargetTransforms.Init(nullptr, Shapes.Num());
+		for (int32 i = 0; i < Frame.ShapeTransformIndices.Num(); ++i)
+		{
+			TargetTransforms[Frame.ShapeTransformIndices[i]] = &Frame.ShapeTransforms[i];
+		}
+		TArray<FBox> SweptShapeBounds;
+		TBitArray<> IsMovingShape(false, Shapes.Num());
+		for (int32 ShapeIndex = 0; ShapeIndex < Shapes.Num(); ++ShapeIndex)
+		{
+			const FTautRopeCollisionShape& Shape = Shapes[ShapeIndex];
+			if (TargetTransforms[ShapeIndex] == nullptr || TargetTransforms[ShapeIndex]->Equals(Shape.Transform))
+			{
+				SweptShapeBounds.Add(Shape.CalcBounds());
+				continue;
+			}
+			double Radius = 0.;
+			if (Shape.IsCurved())
+			{
+				Radius = Shape.Radius + Shape.HalfLength;
+			}
+			else
+			{
+				for (int32 VertIndex = 0; VertIndex < Shape.GetGeometry().Vertices.Num(); ++VertIndex)
+				{
+					Radius = FMath::Max(Radius, Shape.GetLocalVertex(VertIndex).Size());
+				}
+			}
+			FBox SweptBounds(ForceInit);
+			SweptBounds += Shape.Transform.GetLocation();
+			SweptBounds += TargetTransforms[ShapeIndex]->GetLocation();
+			SweptShapeBounds.Add(SweptBounds.ExpandBy(Radius + TAUT_ROPE_DISTANCE_TOLERANCE));
+			IsMovingShape[ShapeIndex] = true;
+		}
+
+		// Shapes touched by the rope are always kept. Moving shapes that are kept grow the bounds by their sweep, which can
+		// pull in further shapes, until nothing changes.
+		TBitArray<> IsKept(false, Shapes.Num());
+		for (const FPoint& Point : RopePoints)
+		{
+			if (Point.ShapeIndex != INDEX_NONE)
+			{
+				IsKept[Point.ShapeIndex] = true;
+			}
+		}
+		bool bHasGrown = true;
+		while (bHasGrown)
+		{
+			bHasGrown = false;
+			for (int32 ShapeIndex = 0; ShapeIndex < Shapes.Num(); ++ShapeIndex)
+			{
+				if (!IsKept[ShapeIndex] && SweptShapeBounds[ShapeIndex].Intersect(UpdateBounds))
+				{
+					IsKept[ShapeIndex] = true;
+				}
+				if (IsKept[ShapeIndex] && IsMovingShape[ShapeIndex])
+				{
+					const FBox GrownBounds = UpdateBounds + SweptShapeBounds[ShapeIndex];
+					bHasGrown |= !(GrownBounds == UpdateBounds);
+					UpdateBounds = GrownBounds;
+				}
+			}
+		}
+
+		FRecording Repro;
+		FRecordingFrame& ReproFrame = Repro.Frames.Add_GetRef(Frame);
+		ReproFrame.ShapeTransformIndices.Reset();
+		ReproFrame.ShapeTransforms.Reset();
+		TArray<int32> ShapeIndexRemap;
+		ShapeIndexRemap.Init(INDEX_NONE, Shapes.Num());
+		for (int32 ShapeIndex = 0; ShapeIndex < Shapes.Num(); ++ShapeIndex)
+		{
+			if (IsKept[ShapeIndex])
+			{
+				ShapeIndexRemap[ShapeIndex] = Repro.Shapes.Add(Shapes[ShapeIndex]);
+				if (TargetTransforms[ShapeIndex] != nullptr)
+				{
+					ReproFrame.ShapeTransformIndices.Add(ShapeIndexRemap[ShapeIndex]);
+					ReproFrame.ShapeTransforms.Add(*TargetTransforms[ShapeIndex]);
+				}
+			}
+		}
+		Repro.InitialRopePoints = RopePoints;
+		for (FPoint& Point : Repro.InitialRopePoints)
+		{
+			if (Point.ShapeIndex != INDEX_NONE)
+			{
+				Point.ShapeIndex = ShapeIndexRemap[Point.ShapeIndex];
+			}
+		}
+		return Repro;
+	}
+
+	FString GetRecordingsDir()
+	{
+		return GetReprosDir() / TEXT("Recordings");
+	}
+
+	FString GetReprosDir()
+	{
+		return FPaths::ProjectSavedDir() / TEXT("TautRope");
+	}
+}
+
+static FAutoConsoleCommand CmdTautRopeRepro(
+	TEXT("TautRope.Repro"),
+	TEXT("Re-runs an automatically captured rope repro from Saved/TautRope in isolation, or lists the captured repros.\n")
+	TEXT("Usage: TautRope.Repro [File] [Repeat]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			if (Args.IsEmpty())
+			{
+				TArray<FString> ReproFiles;
+				IFileManager::Get().FindFiles(ReproFiles, *(TautRope::GetReprosDir() / TEXT("*.trrec")), true, false);
+				for (const FString& ReproFile : ReproFiles)
+				{
+					UE_LOG(LogTautRope, Display, TEXT("%s"), *ReproFile);
+				}
+				return;
+			}
+			FString FilePath = Args[0];
+			if (FPaths::IsRelative(FilePath))
+			{
+				FilePath = TautRope::GetReprosDir() / FilePath;
+			}
+			TautRope::FRecording Repro;
+			if (!Repro.LoadFromFile(FilePath))
+			{
+				UE_LOG(LogTautRope, Warning, TEXT("Failed to load rope repro %s"), *FilePath);
+				return;
+			}
+			const int32 Repeat = Args.IsValidIndex(1) ? FMath::Max(1, FCString::Atoi(*Args[1])) : 1;
+			for (int32 RunIndex = 0; RunIndex < Repeat; ++RunIndex)
+			{
+				TArray<TautRope::FReplayFrameResult> FrameResults;
+				TautRope::ReplayRecording(Repro, FrameResults);
+				TautRope::LogReplayResults(FPaths::GetCleanFilename(FilePath), Repro, FrameResults);
+			}
+		})
+);
+
+static FAutoConsoleCommand CmdTautRopeReplay(
+	TEXT("TautRope.Replay"),
+	TEXT("Re-runs a rope recording as fast as possible and logs per-frame timings.\n")
+	TEXT("Usage: TautRope.Replay <File> [Repeat]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			if (Args.IsEmpty())
+			{
+				UE_LOG(LogTautRope, Warning, TEXT("Usage: TautRope.Replay <File> [Repeat]"));
+				return;
+			}
+			FString FilePath = Args[0];
+			if (FPaths::IsRelative(FilePath))
+			{
+				FilePath = TautRope::GetRecordingsDir() / FilePath;
+			}
+			TautRope::FRecording Recording;
+			if (!Recording.LoadFromFile(FilePath))
+			{
+				UE_LOG(LogTautRope, Warning, TEXT("Failed to load rope recording %s"), *FilePath);
+				return;
+			}
+			const int32 Repeat = Args.IsValidIndex(1) ? FMath::Max(1, FCString::Atoi(*Args[1])) : 1;
+			for (int32 RunIndex = 0; RunIndex < Repeat; ++RunIndex)
+			{
+				TArray<TautRope::FReplayFrameResult> FrameResults;
+				TautRope::ReplayRecording(Recording, FrameResults);
+				TautRope::LogReplayResults(FPaths::GetCleanFilename(FilePath), Recording, FrameResults);
+			}
+		})
+);
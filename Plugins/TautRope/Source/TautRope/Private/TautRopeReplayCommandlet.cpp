@@ -0,0 +1,57 @@
+#include "TautRopeReplayCommandlet.h"
+#include "TautRopeModule.h"
+#include "TautRopeRecording.h"
+
+#include "Misc/Paths.h"
+
+UTautRopeReplayCommandlet::UTautRopeReplayCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UTautRopeReplayCommandlet::Main(const FString& Params)
+{
+	FString FilePath;
+	if (!FParse::Value(*Params, TEXT("File="), FilePath))
+	{
+		UE_LOG(LogTautRope, Error, TEXT("Usage: -run=TautRopeReplay -File=<Recording> [-Repeat=<N>] [-Csv=<Output>]"));
+		return 1;
+	}
+	if (FPaths::IsRelative(FilePath))
+	{
+		FilePath = TautRope::GetRecordingsDir() / FilePath;
+	}
+
+	TautRope::FRecording Recording;
+	if (!Recording.LoadFromFile(FilePath))
+	{
+		UE_LOG(LogTautRope, Error, TEXT("Failed to load rope recording %s"), *FilePath);
+		return 1;
+	}
+
+	int32 Repeat = 1;
+	FParse::Value(*Params, TEXT("Repeat="), Repeat);
+	Repeat = FMath::Max(1, Repeat);
+
+	FString CsvPath;
+	FParse::Value(*Params, TEXT("Csv="), CsvPath);
+
+	for (int32 RunIndex = 0; RunIndex < Repeat; ++RunIndex)
+	{
+		TArray<TautRope::FReplayFrameResult> FrameResults;
+		TautRope::ReplayRecording(Recording, FrameResults);
+		TautRope::LogReplayResults(FPaths::GetCleanFilename(FilePath), Recording, FrameResults);
+		if (!CsvPath.IsEmpty() && RunIndex == Repeat - 1)
+		{
+			if (!TautRope::SaveReplayResultsCsv(CsvPath, Recording, FrameResults))
+			{
+				UE_LOG(LogTautRope, Error, TEXT("Failed to write replay timings to %s"), *CsvPath);
+				return 1;
+			}
+		}
+	}
+	return 0;
+}
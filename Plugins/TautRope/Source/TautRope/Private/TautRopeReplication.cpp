@@ -0,0 +1,420 @@
+#include "TautRopeReplication.h"
+#include "TautRopeModule.h"
+
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+
+namespace TautRope
+{
+	// Quantized endpoints closer than this are not worth sending again.
+	static constexpr float NetLocationTolerance = 0.05f;
+
+	static void SerializeIndex(FArchive& Ar, int32& Index)
+	{
+		// INDEX_NONE is sent as 0 so indices pack into as few bytes as possible.
+		uint32 PackedIndex = static_cast<uint32>(Index + 1);
+		Ar.SerializeIntPacked(PackedIndex);
+		Index = static_cast<int32>(PackedIndex) - 1;
+	}
+
+	static void SerializeLocation(FArchive& Ar, FVector_NetQuantize10& Location)
+	{
+		bool bOutSuccess = true;
+		Location.NetSerialize(Ar, nullptr, bOutSuccess);
+	}
+
+	// Edge parameters are sent with 16 bits, so contacts are stored at that precision to compare as the client sees them.
+	static FPackedPoint QuantizeNetPoint(FPackedPoint Point)
+	{
+		if (!Point.IsCurved() && !Point.IsVertexCrossing())
+		{
+			const uint32 EdgeParam = Point.Param >> 16;
+			Point.Param = (EdgeParam << 16) | EdgeParam;
+		}
+		return Point;
+	}
+
+	static FVector_NetQuantize10 QuantizeNetLocation(const FVector& Location)
+	{
+		return FVector_NetQuantize10(
+			FMath::RoundToDouble(Location.X * 10.) / 10.
+			, FMath::RoundToDouble(Location.Y * 10.) / 10.
+			, FMath::RoundToDouble(Location.Z * 10.) / 10.
+		);
+	}
+
+	// The capsule of another rope's segment whose surface is closest to Location, within half its radius.
+	static int32 FindNetRopeShapeIndex(
+		const FVector& Location
+		, const TArray<FTautRopeCollisionShape>& Shapes
+	)
+	{
+		int32 ClosestShapeIndex = INDEX_NONE;
+		double MinDistance = MAX_dbl;
+		for (int32 ShapeIndex = 0; ShapeIndex < Shapes.Num(); ++ShapeIndex)
+		{
+			const FTautRopeCollisionShape& Shape = Shapes[ShapeIndex];
+			if (!Shape.bIsTransient)
+			{
+				continue;
+			}
+			const FVector Axis = Shape.Transform.GetRotation().GetUpVector() * Shape.HalfLength;
+			const FVector Center = Shape.Transform.GetLocation();
+			const double Distance = FMath::Abs(FMath::PointDistToSegment(Location, Center - Axis, Center + Axis) - Shape.Radius);
+			if (Distance < MinDistance && Distance <= Shape.Radius * 0.5f)
+			{
+				MinDistance = Distance;
+				ClosestShapeIndex = ShapeIndex;
+			}
+		}
+		return ClosestShapeIndex;
+	}
+
+	using FNetShapeCandidates = TArray<int32, TInlineAllocator<2>>;
+
+	// Every shape here with the signature of the contact's shape, the server's index first when it holds one of them.
+	static void FindNetShapeCandidates(
+		const FTautRopeReplicatedState::FContact& Contact
+		, const TMultiMap<uint32, int32>& ShapeIndicesBySignature
+		, FNetShapeCandidates& OutShapeIndices
+	)
+	{
+		OutShapeIndices.Reset();
+		ShapeIndicesBySignature.MultiFind(Contact.ShapeSignature, OutShapeIndices, true);
+		const int32 ServerCandidateIndex = OutShapeIndices.Find(Contact.Point.ShapeIndex);
+		if (ServerCandidateIndex > 0)
+		{
+			OutShapeIndices.Swap(0, ServerCandidateIndex);
+		}
+	}
+
+	static void NetSerializePoint(FArchive& Ar, FPackedPoint& Point)
+	{
+		SerializeIndex(Ar, Point.ShapeIndex);
+		uint8 bIsCurvedBit = Point.IsCurved() ? 1 : 0;
+		Ar.SerializeBits(&bIsCurvedBit, 1);
+		if (bIsCurvedBit != 0)
+		{
+			uint16 AxisParam = static_cast<uint16>(Point.FeatureBits & MAX_uint16);
+			Ar << AxisParam << Point.Param;
+			Point.FeatureBits = FPackedPoint::CurvedBit | AxisParam;
+			return;
+		}
+		int32 EdgeIndex = Point.GetEdgeIndex();
+		SerializeIndex(Ar, EdgeIndex);
+		uint8 bIsVertexCrossingBit = Point.IsVertexCrossing() ? 1 : 0;
+		Ar.SerializeBits(&bIsVertexCrossingBit, 1);
+		Point.FeatureBits = (static_cast<uint32>(EdgeIndex) << 1) | bIsVertexCrossingBit;
+		if (bIsVertexCrossingBit != 0)
+		{
+			// Only which end of the edge is crossed matters.
+			uint8 bIsEdgeEndBit = Point.Param != 0 ? 1 : 0;
+			Ar.SerializeBits(&bIsEdgeEndBit, 1);
+			Point.Param = bIsEdgeEndBit != 0 ? MAX_uint32 : 0;
+		}
+		else
+		{
+			uint16 EdgeParam = static_cast<uint16>(Point.Param >> 16);
+			Ar << EdgeParam;
+			Point.Param = (static_cast<uint32>(EdgeParam) << 16) | EdgeParam;
+		}
+	}
+
+	static void NetSerializeContact(FArchive& Ar, FTautRopeReplicatedState::FContact& Contact)
+	{
+		uint8 bIsOnRopeBit = Contact.bIsOnRope ? 1 : 0;
+		Ar.SerializeBits(&bIsOnRopeBit, 1);
+		Contact.bIsOnRope = bIsOnRopeBit != 0;
+		if (Contact.bIsOnRope)
+		{
+			SerializeLocation(Ar, Contact.RopeLocation);
+			return;
+		}
+		NetSerializePoint(Ar, Contact.Point);
+		Ar << Contact.ShapeSignature;
+	}
+}
+
+class FTautRopeNetBaseState : public INetDeltaBaseState
+{
+public:
+	explicit FTautRopeNetBaseState(const FTautRopeReplicatedState::FState& InState)
+		: State(InState)
+	{}
+
+	virtual bool IsStateEqual(INetDeltaBaseState* OtherState) override
+	{
+		return State.StateId == static_cast<const FTautRopeNetBaseState*>(OtherState)->State.StateId;
+	}
+
+	FTautRopeReplicatedState::FState State;
+};
+
+bool FTautRopeReplicatedState::SetFromRopePoints(
+	const TArray<TautRope::FPoint>& RopePoints
+	, const TArray<FTautRopeCollisionShape>& Shapes
+)
+{
+	if (RopePoints.Num() < 2)
+	{
+		return false;
+	}
+	TArray<FContact> Contacts;
+	Contacts.Reserve(RopePoints.Num() - 2);
+	for (int32 i = 1; i < RopePoints.Num() - 1; ++i)
+	{
+		const FTautRopeCollisionShape& Shape = Shapes[RopePoints[i].ShapeIndex];
+		FContact& Contact = Contacts.AddDefaulted_GetRef();
+		if (Shape.bIsTransient)
+		{
+			Contact.bIsOnRope = true;
+			Contact.RopeLocation = TautRope::QuantizeNetLocation(RopePoints[i].Location);
+			continue;
+		}
+		Contact.Point = TautRope::QuantizeNetPoint(TautRope::PackPoint(RopePoints[i], Shapes));
+		Contact.ShapeSignature = Shape.CalcSignature();
+	}
+	const bool bIsChanged = State.StateId == 0
+		|| !State.StartLocation.Equals(RopePoints[0].Location, TautRope::NetLocationTolerance)
+		|| !State.EndLocation.Equals(RopePoints.Last().Location, TautRope::NetLocationTolerance)
+		|| Contacts != State.Contacts;
+	if (!bIsChanged)
+	{
+		return false;
+	}
+	// 0 means no state, so it is skipped when the id wraps.
+	State.StateId = FMath::Max(State.StateId + 1, 1u);
+	State.StartLocation = RopePoints[0].Location;
+	State.EndLocation = RopePoints.Last().Location;
+	State.Contacts = MoveTemp(Contacts);
+	return true;
+}
+
+bool FTautRopeReplicatedState::ConsumeReceivedState()
+{
+	const bool bWasReceived = bHasReceivedState;
+	bHasReceivedState = false;
+	return bWasReceived;
+}
+
+TArray<TautRope::FPoint> FTautRopeReplicatedState::ToRopePoints(const TArray<FTautRopeCollisionShape>& Shapes) const
+{
+	TautRope::FPackedRopeState PackedState;
+	PackedState.StartLocation = State.StartLocation;
+	PackedState.EndLocation = State.EndLocation;
+	PackedState.Points.Reserve(State.Contacts.Num());
+	TMultiMap<uint32, int32> ShapeIndicesBySignature;
+	for (int32 ShapeIndex = 0; ShapeIndex < Shapes.Num(); ++ShapeIndex)
+	{
+		if (!Shapes[ShapeIndex].bIsTransient)
+		{
+			ShapeIndicesBySignature.Add(Shapes[ShapeIndex].CalcSignature(), ShapeIndex);
+		}
+	}
+	TArray<TautRope::FNetShapeCandidates> CandidateShapeIndices;
+	CandidateShapeIndices.Reserve(State.Contacts.Num());
+	for (const FContact& Contact : State.Contacts)
+	{
+		TautRope::FNetShapeCandidates& Candidates = CandidateShapeIndices.AddDefaulted_GetRef();
+		if (Contact.bIsOnRope)
+		{
+			TautRope::FPoint RopePoint(Contact.RopeLocation);
+			RopePoint.ShapeIndex = TautRope::FindNetRopeShapeIndex(Contact.RopeLocation, Shapes);
+			PackedState.Points.Add(RopePoint.ShapeIndex != INDEX_NONE ? TautRope::PackPoint(RopePoint, Shapes) : TautRope::FPackedPoint());
+			continue;
+		}
+		TautRope::FindNetShapeCandidates(Contact, ShapeIndicesBySignature, Candidates);
+		TautRope::FPackedPoint& Point = PackedState.Points.Add_GetRef(Contact.Point);
+		Point.ShapeIndex = Candidates.IsEmpty() ? INDEX_NONE : Candidates[0];
+	}
+
+	// A taut rope takes the shortest way, so of the shapes sharing a signature the contact goes to the one that keeps the
+	// rope shortest between its neighbors. The server's index wins when the candidates are as short. Contacts on the same
+	// server shape stay on the same shape here and contacts on other server shapes go to other ones, so copies of a shape
+	// each keep their own contacts.
+	TMap<int32, int32> ShapeIndexByServerIndex;
+	TSet<int32> ClaimedShapeIndices;
+	FVector PrevLocation = PackedState.StartLocation;
+	for (int32 i = 0; i < PackedState.Points.Num(); ++i)
+	{
+		TautRope::FPackedPoint& Point = PackedState.Points[i];
+		const TautRope::FNetShapeCandidates& Candidates = CandidateShapeIndices[i];
+		const int32 ServerShapeIndex = State.Contacts[i].Point.ShapeIndex;
+		// Rope contacts have no candidates, they are placed already.
+		if (const int32* MappedShapeIndex = Candidates.Num() > 1 ? ShapeIndexByServerIndex.Find(ServerShapeIndex) : nullptr)
+		{
+			Point.ShapeIndex = *MappedShapeIndex;
+		}
+		else if (Candidates.Num() > 1)
+		{
+			FVector NextLocation = PackedState.EndLocation;
+			for (int32 NextIndex = i + 1; NextIndex < PackedState.Points.Num(); ++NextIndex)
+			{
+				const TautRope::FPoint Next = TautRope::UnpackPoint(PackedState.Points[NextIndex], Shapes);
+				if (Next.ShapeIndex != INDEX_NONE)
+				{
+					NextLocation = Next.Location;
+					break;
+				}
+			}
+			double MinLength = MAX_dbl;
+			int32 BestShapeIndex = Candidates[0];
+			for (const int32 ShapeIndex : Candidates)
+			{
+				if (ClaimedShapeIndices.Contains(ShapeIndex))
+				{
+					continue;
+				}
+				Point.ShapeIndex = ShapeIndex;
+				const TautRope::FPoint Candidate = TautRope::UnpackPoint(Point, Shapes);
+				if (Candidate.ShapeIndex == INDEX_NONE)
+				{
+					continue;
+				}
+				const double Length = FVector::Dist(PrevLocation, Candidate.Location) + FVector::Dist(Candidate.Location, NextLocation);
+				if (Length < MinLength - TAUT_ROPE_DISTANCE_TOLERANCE)
+				{
+					MinLength = Length;
+					BestShapeIndex = ShapeIndex;
+				}
+			}
+			Point.ShapeIndex = BestShapeIndex;
+			ShapeIndexByServerIndex.Add(ServerShapeIndex, BestShapeIndex);
+			ClaimedShapeIndices.Add(BestShapeIndex);
+		}
+		const TautRope::FPoint Resolved = TautRope::UnpackPoint(Point, Shapes);
+		if (Resolved.ShapeIndex != INDEX_NONE)
+		{
+			PrevLocation = Resolved.Location;
+		}
+	}
+	// Contacts on shapes this client did not bake, or on ropes it has not built capsules for, are dropped.
+	return TautRope::UnpackRopePoints(PackedState, Shapes);
+}
+
+bool FTautRopeReplicatedState::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+{
+	static const FState EmptyState;
+	if (DeltaParms.Writer != nullptr)
+	{
+		const FTautRopeNetBaseState* BaseState = static_cast<const FTautRopeNetBaseState*>(DeltaParms.OldState);
+		if (State.StateId == 0 || (BaseState != nullptr && BaseState->State.StateId == State.StateId))
+		{
+			return false;
+		}
+		// Every TAUT_ROPE_NET_STATE_HISTORY states one goes out in full, so a client that lost its base picks up again.
+		// Deltas are only sent against bases from the same run of states, which the client still holds.
+		const bool bIsFullState = BaseState == nullptr
+			|| BaseState->State.StateId / TAUT_ROPE_NET_STATE_HISTORY != State.StateId / TAUT_ROPE_NET_STATE_HISTORY;
+		const FState& Base = bIsFullState ? EmptyState : BaseState->State;
+		FBitWriter& Writer = *DeltaParms.Writer;
+		uint32 StateId = State.StateId;
+		uint32 BaseStateId = Base.StateId;
+		Writer.SerializeIntPacked(StateId);
+		Writer.SerializeIntPacked(BaseStateId);
+
+		FVector_NetQuantize10 StartLocation = State.StartLocation;
+		FVector_NetQuantize10 EndLocation = State.EndLocation;
+		const bool bIsStartChanged = bIsFullState || !Base.StartLocation.Equals(StartLocation, TautRope::NetLocationTolerance);
+		const bool bIsEndChanged = bIsFullState || !Base.EndLocation.Equals(EndLocation, TautRope::NetLocationTolerance);
+		Writer.WriteBit(bIsStartChanged);
+		if (bIsStartChanged)
+		{
+			TautRope::SerializeLocation(Writer, StartLocation);
+		}
+		Writer.WriteBit(bIsEndChanged);
+		if (bIsEndChanged)
+		{
+			TautRope::SerializeLocation(Writer, EndLocation);
+		}
+
+		// Rope changes are local, so only the contacts between the unchanged head and tail are sent.
+		const int32 MaxNumSame = FMath::Min(State.Contacts.Num(), Base.Contacts.Num());
+		int32 NumSameHead = 0;
+		while (NumSameHead < MaxNumSame && State.Contacts[NumSameHead] == Base.Contacts[NumSameHead])
+		{
+			++NumSameHead;
+		}
+		int32 NumSameTail = 0;
+		while (NumSameTail < MaxNumSame - NumSameHead && State.Contacts.Last(NumSameTail) == Base.Contacts.Last(NumSameTail))
+		{
+			++NumSameTail;
+		}
+		uint32 PackedNumSameHead = NumSameHead;
+		uint32 PackedNumSameTail = NumSameTail;
+		uint32 NumChanged = State.Contacts.Num() - NumSameHead - NumSameTail;
+		Writer.SerializeIntPacked(PackedNumSameHead);
+		Writer.SerializeIntPacked(PackedNumSameTail);
+		Writer.SerializeIntPacked(NumChanged);
+		for (int32 i = NumSameHead; i < State.Contacts.Num() - NumSameTail; ++i)
+		{
+			FContact Contact = State.Contacts[i];
+			TautRope::NetSerializeContact(Writer, Contact);
+		}
+
+		*DeltaParms.NewState = MakeShared<FTautRopeNetBaseState>(State);
+		return true;
+	}
+	if (DeltaParms.Reader != nullptr)
+	{
+		FBitReader& Reader = *DeltaParms.Reader;
+		FState NewState;
+		uint32 BaseStateId = 0;
+		Reader.SerializeIntPacked(NewState.StateId);
+		Reader.SerializeIntPacked(BaseStateId);
+		const FState* Base = BaseStateId == 0
+			? &EmptyState
+			: ReceivedStates.FindByPredicate([BaseStateId](const FState& Received)
+				{
+					return Received.StateId == BaseStateId;
+				});
+
+		if (Base != nullptr)
+		{
+			NewState.StartLocation = Base->StartLocation;
+			NewState.EndLocation = Base->EndLocation;
+		}
+		if (Reader.ReadBit())
+		{
+			TautRope::SerializeLocation(Reader, NewState.StartLocation);
+		}
+		if (Reader.ReadBit())
+		{
+			TautRope::SerializeLocation(Reader, NewState.EndLocation);
+		}
+		uint32 NumSameHead = 0;
+		uint32 NumSameTail = 0;
+		uint32 NumChanged = 0;
+		Reader.SerializeIntPacked(NumSameHead);
+		Reader.SerializeIntPacked(NumSameTail);
+		Reader.SerializeIntPacked(NumChanged);
+		TArray<FContact> ChangedContacts;
+		for (uint32 i = 0; i < NumChanged && !Reader.IsError(); ++i)
+		{
+			TautRope::NetSerializeContact(Reader, ChangedContacts.AddDefaulted_GetRef());
+		}
+		if (Reader.IsError())
+		{
+			return false;
+		}
+		if (Base == nullptr || static_cast<int32>(NumSameHead + NumSameTail) > Base->Contacts.Num())
+		{
+			// Deltas against the states held here cannot be trusted any more, the next full state resyncs the rope.
+			UE_LOG(LogTautRope, Warning, TEXT("Dropped rope state %u, its base state %u is no longer known. Waiting for a full state"), NewState.StateId, BaseStateId);
+			ReceivedStates.Reset();
+			return true;
+		}
+		NewState.Contacts.Reserve(NumSameHead + ChangedContacts.Num() + NumSameTail);
+		NewState.Contacts.Append(Base->Contacts.GetData(), NumSameHead);
+		NewState.Contacts.Append(ChangedContacts);
+		NewState.Contacts.Append(Base->Contacts.GetData() + Base->Contacts.Num() - NumSameTail, NumSameTail);
+
+		if (ReceivedStates.Num() >= TAUT_ROPE_NET_STATE_HISTORY)
+		{
+			ReceivedStates.RemoveAt(0);
+		}
+		State = ReceivedStates.Add_GetRef(MoveTemp(NewState));
+		bHasReceivedState = true;
+	}
+	return true;
+}
\ No newline at end of file
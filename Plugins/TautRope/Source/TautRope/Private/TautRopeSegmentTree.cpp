@@ -0,0 +1,178 @@
+#include "TautRopeSegmentTree.h"
+#include "TautRopeConfig.h"
+#include "TautRopeHelpersCurved.h"
+
+#include "Algo/Sort.h"
+
+namespace TautRope
+{
+	static uint32 GetRopeFeatureHash(
+		const TArray<FPoint>& RopePoints
+		, const int32 PointIndex
+	)
+	{
+		const FPoint& Point = RopePoints[PointIndex];
+		if (Point.ShapeIndex == INDEX_NONE)
+		{
+			// The free endpoints, told apart by which end they are.
+			return GetTypeHash(PointIndex == 0);
+		}
+		return GetTypeHash(FIntVector(Point.ShapeIndex, Point.EdgeIndex, Point.VertIndex));
+	}
+
+	void AppendRopeSegments(
+		const TArray<FPoint>& RopePoints
+		, const TArray<FTautRopeCollisionShape>& Shapes
+		, const int32 RopeId
+		, const float Radius
+		, TArray<FRopeSegment>& OutSegments
+	)
+	{
+		for (int32 i = 0; i < RopePoints.Num() - 1; ++i)
+		{
+			if (IsCurvedWrapSegment(RopePoints, i, Shapes))
+			{
+				continue;
+			}
+			FRopeSegment& Segment = OutSegments.AddDefaulted_GetRef();
+			Segment.RopeId = RopeId;
+			Segment.Key = HashCombineFast(GetRopeFeatureHash(RopePoints, i), GetRopeFeatureHash(RopePoints, i + 1));
+			Segment.Start = RopePoints[i].Location;
+			Segment.End = RopePoints[i + 1].Location;
+			Segment.Radius = Radius;
+		}
+	}
+
+	void FRopeSegmentTree::Build(TArray<FRopeSegment>&& InSegments)
+	{
+		Segments = MoveTemp(InSegments);
+		BuildSegmentBounds();
+		SegmentOrder.Reset(Segments.Num());
+		Nodes.Reset();
+		NumRefits = 0;
+		for (int32 SegmentIndex = 0; SegmentIndex < Segments.Num(); ++SegmentIndex)
+		{
+			SegmentOrder.Add(SegmentIndex);
+		}
+		if (Segments.IsEmpty())
+		{
+			return;
+		}
+		Nodes.AddDefaulted();
+		BuildNode(0, 0, Segments.Num());
+	}
+
+	void FRopeSegmentTree::Update(TArray<FRopeSegment>&& InSegments)
+	{
+		bool bIsSameTopology = NumRefits < TAUT_ROPE_SEGMENT_TREE_MAX_REFITS && InSegments.Num() == Segments.Num();
+		for (int32 SegmentIndex = 0; SegmentIndex < Segments.Num() && bIsSameTopology; ++SegmentIndex)
+		{
+			bIsSameTopology = InSegments[SegmentIndex].RopeId == Segments[SegmentIndex].RopeId
+				&& InSegments[SegmentIndex].Key == Segments[SegmentIndex].Key;
+		}
+		if (!bIsSameTopology)
+		{
+			Build(MoveTemp(InSegments));
+			return;
+		}
+		Segments = MoveTemp(InSegments);
+		BuildSegmentBounds();
+		// Children are always added after their parent, so walking the nodes backwards visits children first.
+		for (int32 NodeIndex = Nodes.Num() - 1; NodeIndex >= 0; --NodeIndex)
+		{
+			FNode& Node = Nodes[NodeIndex];
+			if (Node.Count == 0)
+			{
+				Node.Bounds = Nodes[Node.FirstIndex].Bounds + Nodes[Node.FirstIndex + 1].Bounds;
+				continue;
+			}
+			Node.Bounds = FBox(ForceInit);
+			for (int32 i = Node.FirstIndex; i < Node.FirstIndex + Node.Count; ++i)
+			{
+				Node.Bounds += SegmentBounds[SegmentOrder[i]];
+			}
+		}
+		++NumRefits;
+	}
+
+	void FRopeSegmentTree::BuildSegmentBounds()
+	{
+		SegmentBounds.Reset(Segments.Num());
+		for (const FRopeSegment& Segment : Segments)
+		{
+			FBox Bounds(ForceInit);
+			Bounds += Segment.Start;
+			Bounds += Segment.End;
+			SegmentBounds.Add(Bounds.ExpandBy(Segment.Radius));
+		}
+	}
+
+	void FRopeSegmentTree::BuildNode(
+		const int32 NodeIndex
+		, const int32 First
+		, const int32 Count
+	)
+	{
+		FBox Bounds(ForceInit);
+		FBox CenterBounds(ForceInit);
+		for (int32 i = First; i < First + Count; ++i)
+		{
+			Bounds += SegmentBounds[SegmentOrder[i]];
+			CenterBounds += SegmentBounds[SegmentOrder[i]].GetCenter();
+		}
+		Nodes[NodeIndex].Bounds = Bounds;
+		if (Count <= TAUT_ROPE_SEGMENT_TREE_LEAF_SIZE)
+		{
+			Nodes[NodeIndex].FirstIndex = First;
+			Nodes[NodeIndex].Count = Count;
+			return;
+		}
+
+		// Median split along the widest axis of the segment centers keeps the tree balanced.
+		const FVector CenterExtent = CenterBounds.GetExtent();
+		const int32 Axis = CenterExtent.X >= CenterExtent.Y && CenterExtent.X >= CenterExtent.Z ? 0 : (CenterExtent.Y >= CenterExtent.Z ? 1 : 2);
+		Algo::Sort(MakeArrayView(SegmentOrder.GetData() + First, Count), [this, Axis](const int32 A, const int32 B)
+			{
+				return SegmentBounds[A].GetCenter()[Axis] < SegmentBounds[B].GetCenter()[Axis];
+			});
+		const int32 ChildIndex = Nodes.AddDefaulted(2);
+		Nodes[NodeIndex].FirstIndex = ChildIndex;
+		const int32 HalfCount = Count / 2;
+		BuildNode(ChildIndex, First, HalfCount);
+		BuildNode(ChildIndex + 1, First + HalfCount, Count - HalfCount);
+	}
+
+	void FRopeSegmentTree::Query(
+		const FBox& Bounds
+		, TArray<int32>& OutSegmentIndices
+	) const
+	{
+		if (Nodes.IsEmpty())
+		{
+			return;
+		}
+		TArray<int32, TInlineAllocator<64>> NodeStack;
+		NodeStack.Add(0);
+		while (!NodeStack.IsEmpty())
+		{
+			const FNode& Node = Nodes[NodeStack.Pop(EAllowShrinking::No)];
+			if (!Node.Bounds.Intersect(Bounds))
+			{
+				continue;
+			}
+			if (Node.Count == 0)
+			{
+				NodeStack.Add(Node.FirstIndex);
+				NodeStack.Add(Node.FirstIndex + 1);
+				continue;
+			}
+			for (int32 i = Node.FirstIndex; i < Node.FirstIndex + Node.Count; ++i)
+			{
+				if (SegmentBounds[SegmentOrder[i]].Intersect(Bounds))
+				{
+					OutSegmentIndices.Add(SegmentOrder[i]);
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
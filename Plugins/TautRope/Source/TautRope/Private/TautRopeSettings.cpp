@@ -0,0 +1,6 @@
+#include "TautRopeSettings.h"
+
+UTautRopeSettings::UTautRopeSettings()
+{
+	CategoryName = TEXT("Plugins");
+}
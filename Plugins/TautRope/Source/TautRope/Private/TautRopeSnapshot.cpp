@@ -0,0 +1,107 @@
+#include "TautRopeSnapshot.h"
+#include "TautRope.h"
+#include "TautRopeModule.h"
+
+namespace TautRope
+{
+	static constexpr uint32 SnapshotMagic = 0x5452534E; // 'TRSN'
+	static constexpr int32 SnapshotVersion = 1;
+}
+
+bool FTautRopeSnapshot::Capture(const FTautRope& Rope)
+{
+	if (Rope.IsCollisionSolveActive() || Rope.GetNumRopePoints() < 2)
+	{
+		return false;
+	}
+	const TArray<uint32> ShapeSignatures = CalcShapeSignatures(Rope.GetNearbyShapes());
+	ShapesSignature = CalcShapesSignature(ShapeSignatures);
+	State = TautRope::PackRopePoints(Rope.GetPoints(), Rope.GetNearbyShapes());
+	PointShapeSignatures.Reset(State.Points.Num());
+	for (const TautRope::FPackedPoint& Point : State.Points)
+	{
+		PointShapeSignatures.Add(ShapeSignatures[Point.ShapeIndex]);
+	}
+	return true;
+}
+
+bool FTautRopeSnapshot::Restore(
+	FTautRope& Rope
+	, const float MaxLength
+) const
+{
+	if (!IsSet())
+	{
+		return false;
+	}
+	const TArray<FTautRopeCollisionShape>& Shapes = Rope.GetNearbyShapes();
+	const TArray<uint32> ShapeSignatures = CalcShapeSignatures(Shapes);
+	if (CalcShapesSignature(ShapeSignatures) != ShapesSignature || PointShapeSignatures.Num() != State.Points.Num())
+	{
+		UE_LOG(LogTautRope, Log, TEXT("Rope snapshot skipped, the shapes around the rope have changed since it was captured"));
+		return false;
+	}
+	// The same shapes may have been gathered in another order, so points are moved to the shape with their signature.
+	TautRope::FPackedRopeState RestoredState = State;
+	for (int32 PointIndex = 0; PointIndex < RestoredState.Points.Num(); ++PointIndex)
+	{
+		int32& ShapeIndex = RestoredState.Points[PointIndex].ShapeIndex;
+		if (!ShapeSignatures.IsValidIndex(ShapeIndex) || ShapeSignatures[ShapeIndex] != PointShapeSignatures[PointIndex])
+		{
+			ShapeIndex = ShapeSignatures.IndexOfByKey(PointShapeSignatures[PointIndex]);
+		}
+	}
+	TArray<TautRope::FPoint> RopePoints = TautRope::UnpackRopePoints(RestoredState, Shapes);
+	if (RopePoints.Num() != State.Points.Num() + 2)
+	{
+		UE_LOG(LogTautRope, Log, TEXT("Rope snapshot skipped, %d of its points no longer fit their shapes"), State.Points.Num() + 2 - RopePoints.Num());
+		return false;
+	}
+	Rope.ResetRopePoints(RopePoints, MaxLength);
+	return true;
+}
+
+bool FTautRopeSnapshot::Serialize(FArchive& Ar)
+{
+	uint32 Magic = TautRope::SnapshotMagic;
+	int32 Version = TautRope::SnapshotVersion;
+	Ar << Magic << Version;
+	if (Ar.IsLoading() && (Magic != TautRope::SnapshotMagic || Version != TautRope::SnapshotVersion))
+	{
+		// The rope starts again from a straight line. The property tag around the snapshot skips what is left of it.
+		UE_LOG(LogTautRope, Warning, TEXT("Rope snapshot dropped, it was saved with an unknown version %d"), Magic == TautRope::SnapshotMagic ? Version : INDEX_NONE);
+		Reset();
+		return true;
+	}
+	Ar << ShapesSignature << State << PointShapeSignatures;
+	return true;
+}
+
+TArray<uint32> FTautRopeSnapshot::CalcShapeSignatures(const TArray<FTautRopeCollisionShape>& Shapes)
+{
+	TArray<uint32> ShapeSignatures;
+	ShapeSignatures.Reserve(Shapes.Num());
+	for (const FTautRopeCollisionShape& Shape : Shapes)
+	{
+		// Contacts with other ropes are not captured, so their stand in shapes are left out.
+		ShapeSignatures.Add(Shape.bIsTransient ? 0 : Shape.CalcSignature());
+	}
+	return ShapeSignatures;
+}
+
+uint32 FTautRopeSnapshot::CalcShapesSignature(const TArray<uint32>& ShapeSignatures)
+{
+	// Shapes are gathered in overlap order, which may differ between runs, so their signatures are combined sorted.
+	TArray<uint32> SortedSignatures = ShapeSignatures;
+	SortedSignatures.Sort();
+	uint32 Signature = 0;
+	for (const uint32 ShapeSignature : SortedSignatures)
+	{
+		if (ShapeSignature != 0)
+		{
+			Signature = HashCombineFast(Signature, ShapeSignature);
+		}
+	}
+	// 0 is kept for no snapshot.
+	return FMath::Max(Signature, 1u);
+}
\ No newline at end of file
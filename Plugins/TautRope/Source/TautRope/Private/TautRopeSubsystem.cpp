@@ -0,0 +1,160 @@
+#include "TautRopeSubsystem.h"
+#include "TautRope.h"
+#include "TautRopeActor.h"
+#include "TautRopeModule.h"
+#include "TautRopeSettings.h"
+
+DECLARE_CYCLE_STAT(TEXT("Tick"), STAT_TautRopeSubsystemTick, STATGROUP_TautRope);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Budget (ms)"), STAT_TautRopeBudgetMs, STATGROUP_TautRope);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Spent (ms)"), STAT_TautRopeSpentMs, STATGROUP_TautRope);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Queue Depth"), STAT_TautRopeQueueDepth, STATGROUP_TautRope);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Updated"), STAT_TautRopeUpdated, STATGROUP_TautRope);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Deferred"), STAT_TautRopeDeferred, STATGROUP_TautRope);
+
+void UTautRopeSubsystem::RegisterRope(ATautRopeActor* Rope)
+{
+	const bool bIsRegistered = ScheduledRopes.ContainsByPredicate([Rope](const FScheduledRope& Scheduled)
+		{
+			return Scheduled.Rope == Rope;
+		});
+	if (!bIsRegistered)
+	{
+		FScheduledRope& Scheduled = ScheduledRopes.AddDefaulted_GetRef();
+		Scheduled.Rope = Rope;
+		Scheduled.RopeId = NextRopeId++;
+	}
+}
+
+void UTautRopeSubsystem::UnregisterRope(ATautRopeActor* Rope)
+{
+	// Ropes destroyed from the contact events of a tick are only cleared, so the tick's indices stay valid.
+	if (bIsTicking)
+	{
+		for (FScheduledRope& Scheduled : ScheduledRopes)
+		{
+			if (Scheduled.Rope == Rope)
+			{
+				Scheduled.Rope = nullptr;
+			}
+		}
+		return;
+	}
+	ScheduledRopes.RemoveAll([Rope](const FScheduledRope& Scheduled)
+		{
+			return Scheduled.Rope == Rope;
+		});
+}
+
+void UTautRopeSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TautRopeSubsystemTick);
+
+	const UTautRopeSettings* Settings = GetDefault<UTautRopeSettings>();
+	ScheduledRopes.RemoveAll([](const FScheduledRope& Scheduled)
+		{
+			return !Scheduled.Rope.IsValid();
+		});
+	TGuardValue<bool> TickingGuard(bIsTicking, true);
+
+	TArray<TautRope::FRopeSegment> RopeSegments;
+	for (const FScheduledRope& Scheduled : ScheduledRopes)
+	{
+		Scheduled.Rope->AppendRopeSegments(Scheduled.RopeId, RopeSegments);
+	}
+	RopeSegmentTree.Update(MoveTemp(RopeSegments));
+
+	struct FQueuedRope
+	{
+		int32 ScheduledIndex = INDEX_NONE;
+		bool bIsStarved = false;
+		float Priority = 0.f;
+	};
+	TArray<FQueuedRope> Queue;
+	for (int32 ScheduledIndex = 0; ScheduledIndex < ScheduledRopes.Num(); ++ScheduledIndex)
+	{
+		FScheduledRope& Scheduled = ScheduledRopes[ScheduledIndex];
+		ATautRopeActor* Rope = Scheduled.Rope.Get();
+		Rope->AdvanceSchedule(DeltaTime);
+		if (!Rope->IsUpdateDue())
+		{
+			continue;
+		}
+		FQueuedRope& Queued = Queue.AddDefaulted_GetRef();
+		Queued.ScheduledIndex = ScheduledIndex;
+		Queued.bIsStarved = Scheduled.FramesDeferred >= Settings->MaxDeferredFrames;
+		// Waiting raises priority so low importance ropes cannot be deferred forever.
+		Queued.Priority = Rope->GetUpdateImportance() + Scheduled.FramesDeferred;
+	}
+	Queue.Sort([](const FQueuedRope& A, const FQueuedRope& B)
+		{
+			if (A.bIsStarved != B.bIsStarved)
+			{
+				return A.bIsStarved;
+			}
+			return A.Priority > B.Priority;
+		});
+
+	const double BudgetMs = Settings->FrameBudgetMs;
+	const double StartSeconds = FPlatformTime::Seconds();
+	double SpentMs = 0.0;
+	int32 NumUpdated = 0;
+	for (const FQueuedRope& Queued : Queue)
+	{
+		ATautRopeActor* Rope = ScheduledRopes[Queued.ScheduledIndex].Rope.Get();
+		if (Rope == nullptr)
+		{
+			continue;
+		}
+		// The first update always runs so the queue keeps draining on any budget.
+		const bool bFitsBudget = BudgetMs <= 0.0 || NumUpdated == 0 || SpentMs + ScheduledRopes[Queued.ScheduledIndex].EstimatedMs <= BudgetMs;
+		if (!bFitsBudget)
+		{
+			ScheduledRopes[Queued.ScheduledIndex].FramesDeferred++;
+			continue;
+		}
+		const double RopeStartSeconds = FPlatformTime::Seconds();
+		Rope->UpdateForeignRopeSegments(RopeSegmentTree, ScheduledRopes[Queued.ScheduledIndex].RopeId);
+		// Contact events fire from here and may register or destroy ropes, so the entry is looked up again after.
+		Rope->UpdateSimulation();
+		const double RopeEndSeconds = FPlatformTime::Seconds();
+		const float RopeMs = (RopeEndSeconds - RopeStartSeconds) * 1000.0;
+		FScheduledRope& Scheduled = ScheduledRopes[Queued.ScheduledIndex];
+		Scheduled.EstimatedMs = Scheduled.EstimatedMs > 0.f ? FMath::Lerp(Scheduled.EstimatedMs, RopeMs, 0.25f) : RopeMs;
+		Scheduled.FramesDeferred = 0;
+		SpentMs = (RopeEndSeconds - StartSeconds) * 1000.0;
+		NumUpdated++;
+	}
+
+	for (int32 ScheduledIndex = 0; ScheduledIndex < ScheduledRopes.Num(); ++ScheduledIndex)
+	{
+		if (ATautRopeActor* Rope = ScheduledRopes[ScheduledIndex].Rope.Get())
+		{
+			Rope->PublishRopePoints();
+		}
+	}
+	ScheduledRopes.RemoveAll([](const FScheduledRope& Scheduled)
+		{
+			return !Scheduled.Rope.IsValid();
+		});
+
+	Stats.BudgetMs = BudgetMs;
+	Stats.SpentMs = SpentMs;
+	Stats.QueueDepth = Queue.Num();
+	Stats.NumUpdated = NumUpdated;
+	Stats.NumDeferred = Queue.Num() - NumUpdated;
+	SET_FLOAT_STAT(STAT_TautRopeBudgetMs, Stats.BudgetMs);
+	SET_FLOAT_STAT(STAT_TautRopeSpentMs, Stats.SpentMs);
+	SET_DWORD_STAT(STAT_TautRopeQueueDepth, Stats.QueueDepth);
+	SET_DWORD_STAT(STAT_TautRopeUpdated, Stats.NumUpdated);
+	SET_DWORD_STAT(STAT_TautRopeDeferred, Stats.NumDeferred);
+}
+
+TStatId UTautRopeSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTautRopeSubsystem, STATGROUP_Tickables);
+}
+
+bool UTautRopeSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
@@ -0,0 +1,106 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "TautRope.h"
+#include "TautRopeCollisionShape.h"
+#include "TautRopeHelpersPruning.h"
+
+namespace TautRopeCollisionShapeTests
+{
+	static constexpr double WallHeight = 100.;
+	static constexpr double WallHalfWidth = 50.;
+
+	// Finds the baked edge along the top of the wall, returns false if it was dropped.
+	static bool FindTopEdge(
+		const TArray<FTautRopeCollisionShape>& Shapes
+		, int32& OutShapeIndex
+		, int32& OutEdgeIndex
+	)
+	{
+		for (int32 ShapeIndex = 0; ShapeIndex < Shapes.Num(); ++ShapeIndex)
+		{
+			const FTautRopeCollisionShape& Shape = Shapes[ShapeIndex];
+			for (int32 EdgeIndex = 0; EdgeIndex < Shape.Edges.Num(); ++EdgeIndex)
+			{
+				const FIntVector2& Edge = Shape.Edges[EdgeIndex];
+				if (FMath::IsNearlyEqual(Shape.GetVertex(Edge.X).Z, WallHeight) && FMath::IsNearlyEqual(Shape.GetVertex(Edge.Y).Z, WallHeight))
+				{
+					OutShapeIndex = ShapeIndex;
+					OutEdgeIndex = EdgeIndex;
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FTautRopeCollisionShapeOpenBorderTest
+	, "TautRope.CollisionShape.OpenBorder"
+	, EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter
+)
+
+bool FTautRopeCollisionShapeOpenBorderTest::RunTest(const FString& Parameters)
+{
+	using namespace TautRopeCollisionShapeTests;
+
+	// A single sided wall in the XZ plane, the rope hangs over its top from one side to the other.
+	const TArray<FVector3f> MeshVertices = {
+		FVector3f(-WallHalfWidth, 0., 0.)
+		, FVector3f(WallHalfWidth, 0., 0.)
+		, FVector3f(WallHalfWidth, 0., WallHeight)
+		, FVector3f(-WallHalfWidth, 0., WallHeight)
+	};
+	const TArray<FIntVector> MeshTriangles = { FIntVector(0, 1, 2), FIntVector(0, 2, 3) };
+	TArray<FTautRopeCollisionShape> Shapes;
+	FTautRopeCollisionShape::AppendTriangleMeshShapes(MeshVertices, MeshTriangles, FTransform::Identity, Shapes);
+
+	int32 ShapeIndex = INDEX_NONE;
+	int32 EdgeIndex = INDEX_NONE;
+	if (!TestTrue(TEXT("Top border of the quad is baked"), FindTopEdge(Shapes, ShapeIndex, EdgeIndex)))
+	{
+		return true;
+	}
+
+	const FVector Start(0., -100., WallHeight * 0.5);
+	const FVector End(0., 100., WallHeight * 0.5);
+	const FVector Contact(0., 0., WallHeight);
+	const FQuat& EdgeRotation = Shapes[ShapeIndex].EdgeRotations[EdgeIndex];
+	TestTrue(TEXT("Rope over the top border wraps it"), TautRope::IsRopeWrappingEdge(Start, Contact, End, EdgeRotation));
+	TestFalse(
+		TEXT("Rope passing above the top border doesn't wrap it")
+		, TautRope::IsRopeWrappingEdge(Start + FVector(0., 0., 2. * WallHeight), Contact, End + FVector(0., 0., 2. * WallHeight), EdgeRotation)
+	);
+
+	// The full update keeps the contact instead of pruning it.
+	FTautRope Rope;
+	Rope.AppendToNearbyShapes(Shapes);
+	TautRope::FPoint Point(Contact);
+	Point.ShapeIndex = ShapeIndex;
+	Point.EdgeIndex = EdgeIndex;
+	const float MaxLength = 300.f;
+	Rope.ResetRopePoints({ TautRope::FPoint(Start), Point, TautRope::FPoint(End) }, MaxLength);
+	for (int32 Update = 0; Update < 4; ++Update)
+	{
+		Rope.UpdateRope(
+			Start
+			, End
+			, MaxLength
+#if TAUT_ROPE_DEBUG_DRAWING
+			, nullptr
+#endif // TAUT_ROPE_DEBUG_DRAWING
+		);
+	}
+	const TArray<TautRope::FPoint>& RopePoints = Rope.GetPoints();
+	TestEqual(TEXT("Rope keeps its contact on the top border"), RopePoints.Num(), 3);
+	if (RopePoints.Num() == 3)
+	{
+		TestEqual(TEXT("Contact stays on the top border"), RopePoints[1].EdgeIndex, EdgeIndex);
+		TestTrue(TEXT("Contact stays at the top of the wall"), FMath::IsNearlyEqual(RopePoints[1].Location.Z, WallHeight, 0.1));
+	}
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
\ No newline at end of file
@@ -0,0 +1,307 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Components/SceneComponent.h"
+#include "Engine/Level.h"
+#include "PhysicsEngine/BoxElem.h"
+#include "PhysicsEngine/SphereElem.h"
+#include "PhysicsEngine/SphylElem.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+#include "TautRopeReplication.h"
+
+namespace TautRopeReplicationTests
+{
+	static constexpr float SphereRadius = 10.f;
+	// Endpoints are quantized to a tenth of a unit and curved contacts to 16 bits per axis.
+	static constexpr float LocationTolerance = 0.5f;
+
+	static TArray<FTautRopeCollisionShape> MakeSpheres(const TArray<FVector>& Centers)
+	{
+		TArray<FTautRopeCollisionShape> Shapes;
+		for (const FVector& Center : Centers)
+		{
+			FKSphereElem Sphere(SphereRadius);
+			Sphere.Center = Center;
+			Shapes.Emplace(Sphere, FTransform::Identity);
+		}
+		return Shapes;
+	}
+
+	// A component named like the one every copy of a Blueprint has, on an owner named OwnerName in Level.
+	static USceneComponent* MakeComponent(UObject* Level, const TCHAR* OwnerName, const FVector& Location)
+	{
+		UObject* Owner = NewObject<USceneComponent>(Level, OwnerName);
+		USceneComponent* Component = NewObject<USceneComponent>(Owner, TEXT("Mesh"));
+		Component->SetWorldLocation(Location);
+		return Component;
+	}
+
+	static TArray<FTautRopeCollisionShape> MakeComponentSpheres(const TArray<USceneComponent*>& Components)
+	{
+		TArray<FTautRopeCollisionShape> Shapes;
+		for (USceneComponent* Component : Components)
+		{
+			Shapes.Emplace(FKSphereElem(SphereRadius), Component);
+		}
+		return Shapes;
+	}
+
+	// A segment of another rope across the X axis at X, as FTautRope::SetForeignRopeSegments builds it.
+	static FTautRopeCollisionShape MakeRopeCapsule(const double X)
+	{
+		FKSphylElem Capsule(SphereRadius, 200.f);
+		Capsule.Center = FVector(X, 0., 0.);
+		Capsule.Rotation = FRotator(0., 0., 90.);
+		FTautRopeCollisionShape Shape(Capsule, FTransform::Identity);
+		Shape.bIsTransient = true;
+		return Shape;
+	}
+
+	// A rope from Start to End over the top of every sphere, or under it where the index is in Under.
+	static TArray<TautRope::FPoint> MakeRopePoints(
+		const FVector& Start
+		, const FVector& End
+		, const TArray<FTautRopeCollisionShape>& Shapes
+		, const TArray<int32>& Under = {}
+	)
+	{
+		TArray<TautRope::FPoint> RopePoints;
+		RopePoints.Add(TautRope::FPoint(Start));
+		for (int32 ShapeIndex = 0; ShapeIndex < Shapes.Num(); ++ShapeIndex)
+		{
+			const float Side = Under.Contains(ShapeIndex) ? -1.f : 1.f;
+			TautRope::FPoint& Contact = RopePoints.Add_GetRef(TautRope::FPoint(Shapes[ShapeIndex].Transform.GetLocation() + FVector(0., 0., Side * SphereRadius)));
+			Contact.ShapeIndex = ShapeIndex;
+		}
+		RopePoints.Add(TautRope::FPoint(End));
+		return RopePoints;
+	}
+
+	// Sends the server state to the client as a connection that acknowledged InOutBaseState would, and makes the sent
+	// state the new base. Returns false if nothing was sent.
+	static bool SendState(
+		FTautRopeReplicatedState& Server
+		, FTautRopeReplicatedState& Client
+		, TSharedPtr<INetDeltaBaseState>& InOutBaseState
+	)
+	{
+		FBitWriter Writer(0, true);
+		TSharedPtr<INetDeltaBaseState> NewBaseState;
+		FNetDeltaSerializeInfo WriteParms;
+		WriteParms.Writer = &Writer;
+		WriteParms.OldState = InOutBaseState.Get();
+		WriteParms.NewState = &NewBaseState;
+		if (!Server.NetDeltaSerialize(WriteParms))
+		{
+			return false;
+		}
+		FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+		FNetDeltaSerializeInfo ReadParms;
+		ReadParms.Reader = &Reader;
+		Client.NetDeltaSerialize(ReadParms);
+		InOutBaseState = NewBaseState;
+		return !Reader.IsError();
+	}
+
+	static bool IsSameRope(
+		const TArray<TautRope::FPoint>& Expected
+		, const TArray<TautRope::FPoint>& Received
+	)
+	{
+		if (Expected.Num() != Received.Num())
+		{
+			return false;
+		}
+		for (int32 i = 0; i < Expected.Num(); ++i)
+		{
+			if (!Expected[i].Location.Equals(Received[i].Location, LocationTolerance))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FTautRopeReplicationRoundTripTest
+	, "TautRope.Replication.RoundTrip"
+	, EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter
+)
+
+bool FTautRopeReplicationRoundTripTest::RunTest(const FString& Parameters)
+{
+	using namespace TautRopeReplicationTests;
+
+	const TArray<FVector> Centers = { FVector(0., 0., 0.), FVector(100., 0., 0.), FVector(200., 0., 0.) };
+	const TArray<FTautRopeCollisionShape> ServerShapes = MakeSpheres(Centers);
+	// The client gathered the same shapes in another order.
+	const TArray<FTautRopeCollisionShape> ClientShapes = MakeSpheres({ Centers[2], Centers[0], Centers[1] });
+	const FVector Start(-100., 0., 0.);
+	const FVector End(300., 0., 0.);
+
+	FTautRopeReplicatedState Server;
+	FTautRopeReplicatedState Client;
+	TSharedPtr<INetDeltaBaseState> BaseState;
+
+	// Full state, sent without a base.
+	TArray<TautRope::FPoint> RopePoints = MakeRopePoints(Start, End, ServerShapes);
+	Server.SetFromRopePoints(RopePoints, ServerShapes);
+	TestTrue(TEXT("Full state is sent"), SendState(Server, Client, BaseState));
+	TestTrue(TEXT("Full state is received"), Client.ConsumeReceivedState());
+	TestTrue(TEXT("Full state places contacts on the client's shapes"), IsSameRope(RopePoints, Client.ToRopePoints(ClientShapes)));
+
+	// Delta, only the middle contact and the end changed.
+	RopePoints = MakeRopePoints(Start, End + FVector(0., 0., 50.), ServerShapes, { 1 });
+	Server.SetFromRopePoints(RopePoints, ServerShapes);
+	TestTrue(TEXT("Delta is sent"), SendState(Server, Client, BaseState));
+	TestTrue(TEXT("Delta is received"), Client.ConsumeReceivedState());
+	TestTrue(TEXT("Delta rebuilds the rope"), IsSameRope(RopePoints, Client.ToRopePoints(ClientShapes)));
+
+	// A client missing the base drops deltas until the next full state, then matches again.
+	FTautRopeReplicatedState LateClient;
+	TSharedPtr<INetDeltaBaseState> LateBaseState = BaseState;
+	bool bIsResynced = false;
+	for (int32 Change = 0; Change <= TAUT_ROPE_NET_STATE_HISTORY && !bIsResynced; ++Change)
+	{
+		RopePoints = MakeRopePoints(Start + FVector(0., 0., Change + 1.), End, ServerShapes, { Change % Centers.Num() });
+		Server.SetFromRopePoints(RopePoints, ServerShapes);
+		SendState(Server, LateClient, LateBaseState);
+		bIsResynced = LateClient.ConsumeReceivedState();
+	}
+	TestTrue(TEXT("Client with an unknown base receives a full state"), bIsResynced);
+	TestTrue(TEXT("Full state after an unknown base rebuilds the rope"), IsSameRope(RopePoints, LateClient.ToRopePoints(ClientShapes)));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FTautRopeReplicationDuplicateShapesTest
+	, "TautRope.Replication.DuplicateShapes"
+	, EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter
+)
+
+bool FTautRopeReplicationDuplicateShapesTest::RunTest(const FString& Parameters)
+{
+	using namespace TautRopeReplicationTests;
+
+	const FVector Start(-100., 0., 0.);
+	const FVector End(300., 0., 0.);
+
+	// The same Blueprint placed twice in a level, with the same shape at the same spot of its component.
+	UObject* Level = NewObject<ULevel>(GetTransientPackage());
+	USceneComponent* CrateA = MakeComponent(Level, TEXT("Crate_1"), FVector(0., 0., 0.));
+	USceneComponent* CrateB = MakeComponent(Level, TEXT("Crate_2"), FVector(100., 0., 0.));
+	{
+		const TArray<FTautRopeCollisionShape> ServerShapes = MakeComponentSpheres({ CrateA, CrateB });
+		const TArray<FTautRopeCollisionShape> ClientShapes = MakeComponentSpheres({ CrateB, CrateA });
+		TestTrue(TEXT("Copies of a Blueprint get their own signatures"), ServerShapes[0].CalcSignature() != ServerShapes[1].CalcSignature());
+
+		FTautRopeReplicatedState Server;
+		FTautRopeReplicatedState Client;
+		TSharedPtr<INetDeltaBaseState> BaseState;
+		const TArray<TautRope::FPoint> RopePoints = MakeRopePoints(Start, End, ServerShapes, { 1 });
+		Server.SetFromRopePoints(RopePoints, ServerShapes);
+		SendState(Server, Client, BaseState);
+		Client.ConsumeReceivedState();
+		TestTrue(TEXT("Contacts on copies of a Blueprint go to their own copy"), IsSameRope(RopePoints, Client.ToRopePoints(ClientShapes)));
+	}
+
+	// Two copies of a sublevel, whose components share their paths within the level.
+	UObject* OtherLevel = NewObject<ULevel>(GetTransientPackage());
+	USceneComponent* OtherCrate = MakeComponent(OtherLevel, TEXT("Crate_1"), FVector(100., 0., 0.));
+	{
+		const TArray<FTautRopeCollisionShape> ServerShapes = MakeComponentSpheres({ CrateA, OtherCrate });
+		const TArray<FTautRopeCollisionShape> ClientShapes = MakeComponentSpheres({ OtherCrate, CrateA });
+		TestTrue(TEXT("Components with the same path in their levels share signatures"), ServerShapes[0].CalcSignature() == ServerShapes[1].CalcSignature());
+
+		FTautRopeReplicatedState Server;
+		FTautRopeReplicatedState Client;
+		TSharedPtr<INetDeltaBaseState> BaseState;
+		const TArray<TautRope::FPoint> RopePoints = MakeRopePoints(Start, End, ServerShapes, { 1 });
+		Server.SetFromRopePoints(RopePoints, ServerShapes);
+		SendState(Server, Client, BaseState);
+		Client.ConsumeReceivedState();
+		TestTrue(TEXT("Contacts on shapes sharing a signature keep the rope consistent"), IsSameRope(RopePoints, Client.ToRopePoints(ClientShapes)));
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FTautRopeReplicationRopeContactsTest
+	, "TautRope.Replication.RopeContacts"
+	, EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter
+)
+
+bool FTautRopeReplicationRopeContactsTest::RunTest(const FString& Parameters)
+{
+	using namespace TautRopeReplicationTests;
+
+	TArray<FTautRopeCollisionShape> ServerShapes = MakeSpheres({ FVector(0., 0., 0.) });
+	ServerShapes.Add(MakeRopeCapsule(100.));
+	// The client built its capsule for the other rope before baking its own shapes.
+	TArray<FTautRopeCollisionShape> ClientShapes = { MakeRopeCapsule(100.) };
+	ClientShapes.Append(MakeSpheres({ FVector(0., 0., 0.) }));
+	const TArray<TautRope::FPoint> RopePoints = MakeRopePoints(FVector(-100., 0., 0.), FVector(200., 0., 0.), ServerShapes);
+
+	FTautRopeReplicatedState Server;
+	FTautRopeReplicatedState Client;
+	TSharedPtr<INetDeltaBaseState> BaseState;
+	Server.SetFromRopePoints(RopePoints, ServerShapes);
+	SendState(Server, Client, BaseState);
+	Client.ConsumeReceivedState();
+	const TArray<TautRope::FPoint> Received = Client.ToRopePoints(ClientShapes);
+	TestTrue(TEXT("Contacts with other ropes are rebuilt on the client's capsules"), IsSameRope(RopePoints, Received));
+	TestTrue(TEXT("Contacts with other ropes rest on the capsule"), Received.Num() == RopePoints.Num() && Received[2].ShapeIndex == 0);
+
+	const TArray<FTautRopeCollisionShape> ClientShapesWithoutRope = MakeSpheres({ FVector(0., 0., 0.) });
+	TestEqual(TEXT("Contacts with ropes the client has no capsule for are dropped"), Client.ToRopePoints(ClientShapesWithoutRope).Num(), RopePoints.Num() - 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FTautRopeReplicationEdgeParamTest
+	, "TautRope.Replication.EdgeParam"
+	, EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter
+)
+
+bool FTautRopeReplicationEdgeParamTest::RunTest(const FString& Parameters)
+{
+	using namespace TautRopeReplicationTests;
+
+	TArray<FTautRopeCollisionShape> Shapes;
+	Shapes.Emplace(FKBoxElem(100.f), FTransform(FVector(0., 0., 50.)));
+	const FTautRopeCollisionShape& Box = Shapes[0];
+
+	FTautRopeReplicatedState Server;
+	FTautRopeReplicatedState Client;
+	TSharedPtr<INetDeltaBaseState> BaseState;
+	for (int32 EdgeIndex = 0; EdgeIndex < Box.GetGeometry().Edges.Num(); ++EdgeIndex)
+	{
+		const FIntVector2& Edge = Box.GetGeometry().Edges[EdgeIndex];
+		const FVector EdgeStart = Box.GetVertex(Edge.X);
+		const FVector EdgeEnd = Box.GetVertex(Edge.Y);
+		// One step of 16 bits along the edge from cutting the parameter, and another from spreading it over 32 bits again.
+		const double Tolerance = 2. * FVector::Dist(EdgeStart, EdgeEnd) / MAX_uint16;
+		for (const double Alpha : { 0.0001, 0.3, 0.5, 0.77, 0.9999 })
+		{
+			TautRope::FPoint Contact(FMath::Lerp(EdgeStart, EdgeEnd, Alpha));
+			Contact.ShapeIndex = 0;
+			Contact.EdgeIndex = EdgeIndex;
+			const TArray<TautRope::FPoint> RopePoints = { TautRope::FPoint(FVector(-200., 0., 50.)), Contact, TautRope::FPoint(FVector(200., 0., 50.)) };
+
+			Server.SetFromRopePoints(RopePoints, Shapes);
+			SendState(Server, Client, BaseState);
+			Client.ConsumeReceivedState();
+			const TArray<TautRope::FPoint> Received = Client.ToRopePoints(Shapes);
+			const bool bIsSameContact = Received.Num() == RopePoints.Num()
+				&& Received[1].EdgeIndex == EdgeIndex
+				&& Received[1].Location.Equals(Contact.Location, Tolerance);
+			TestTrue(FString::Printf(TEXT("Edge %d at %.4f survives the 16 bit parameter"), EdgeIndex, Alpha), bIsSameContact);
+		}
+	}
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
\ No newline at end of file
@@ -3,10 +3,21 @@
 #include "CoreMinimal.h"
 #include "TautRopeCollisionShape.h"
 #include "TautRopeConfig.h"
+#include "TautRopeHelpersCollision.h"
+#include "TautRopePackedPoint.h"
 #include "TautRopePoint.h"
+#include "TautRopeSegmentTree.h"
 
 #include "TautRope.generated.h"
 
+namespace TautRope
+{
+	struct FRecording;
+}
+
+// Shape index and location of a contact the rope gained or lost.
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnTautRopeContactChanged, const int32, const FVector&);
+
 
 USTRUCT()
 struct TAUTROPE_API FTautRope
@@ -16,8 +27,63 @@ struct TAUTROPE_API FTautRope
 public:
 	void AppendToNearbyShapes(const TConstArrayView<FTautRopeCollisionShape>& Shapes);
 
+	// While a collision solve is spread over several updates this is the last consistent path.
 	TArray<FVector> GetRopePoints() const;
 
+	int32 GetNumRopePoints() const { return RopePoints.Num(); }
+	const TArray<TautRope::FPoint>& GetPoints() const { return RopePoints; }
+	const TArray<FTautRopeCollisionShape>& GetNearbyShapes() const { return NearbyShapes; }
+	bool IsCollisionSolveActive() const { return CollisionSolve.bIsActive; }
+
+	// Same locations as GetRopePoints without the copy, valid until the next UpdateRope or ResetRopePoints.
+	TConstArrayView<FVector> GetRopeLocations() const { return PathLocations; }
+	// Per location of GetRopeLocations, the shape, edge and vertex index of the contact it belongs to. Arc locations
+	// belong to the shape they wrap around.
+	TConstArrayView<FIntVector> GetRopeFeatures() const { return PathFeatures; }
+	// Bumped whenever GetRopeLocations changes, so consumers can skip unchanged ropes.
+	uint32 GetPathVersion() const { return PathVersion; }
+
+	// Broadcast after the update that made or broke a contact, once its collision solve has completed.
+	FOnTautRopeContactChanged OnContactAdded;
+	FOnTautRopeContactChanged OnContactRemoved;
+
+	// Arc length queries along GetRopePoints, served from a cumulative length table that UpdateRope keeps current.
+	float GetLength() const { return CumulativeArcLengths.IsEmpty() ? 0.f : CumulativeArcLengths.Last(); }
+	float GetSlack() const { return ArcMaxLength - GetLength(); }
+	FVector GetLocationAtDistance(const float Distance) const;
+	FVector GetTangentAtDistance(const float Distance) const;
+	// Linear in the number of rope points, the table only speeds up queries by distance.
+	float GetDistanceClosestToLocation(const FVector& Location) const;
+
+	// Replaces the segments of other ropes this rope wraps over, each as a capsule after the nearby shapes.
+	// Contacts move along with their segment, or to the closest new segment of the same rope once it is gone.
+	// Ignored while a collision solve is in progress, which keeps the segments it started with.
+	void SetForeignRopeSegments(const TConstArrayView<TautRope::FRopeSegment> Segments);
+
+	// Moves a local space shape that has no owning component, e.g. when replaying a recording.
+	void SetShapeTargetTransform(const int32 ShapeIndex, const FTransform& TargetTransform);
+
+	// Replaces the current rope state, e.g. to restart from a recorded state.
+	void ResetRopePoints(
+		const TArray<TautRope::FPoint>& InRopePoints
+		, const float MaxLength
+	);
+
+	// The rope as shape features instead of locations, see TautRope::FPackedRopeState.
+	TautRope::FPackedRopeState GetPackedState() const { return TautRope::PackRopePoints(RopePoints, NearbyShapes); }
+	void ResetFromPackedState(
+		const TautRope::FPackedRopeState& State
+		, const float MaxLength
+	)
+	{
+		ResetRopePoints(TautRope::UnpackRopePoints(State, NearbyShapes), MaxLength);
+	}
+
+	// Captures the nearby shapes, current rope points and every following UpdateRope input.
+	void StartRecording();
+	TSharedPtr<TautRope::FRecording> StopRecording();
+	bool IsRecording() const { return ActiveRecording.IsValid(); }
+
 	void UpdateRope(
 		const FVector& StartLocation
 		, const FVector& EndLocation
@@ -32,13 +98,37 @@ public:
 #endif // TAUT_ROPE_DEBUG_DRAWING
 
 private:
+	// Both return false when the collision solve ran out of budget and has to be resumed by a later update.
+	bool StepRope(
+		const FVector& StartLocation
+		, const FVector& EndLocation
+		, const float MaxLength
+		, int32& InOutCollisionIterationBudget
+		, const double CollisionDeadlineSeconds
+#if TAUT_ROPE_DEBUG_DRAWING
+		, const UWorld* World
+#endif // TAUT_ROPE_DEBUG_DRAWING
+	);
+	bool ResumeStep(
+		int32& InOutCollisionIterationBudget
+		, const double CollisionDeadlineSeconds
+#if TAUT_ROPE_DEBUG_DRAWING
+		, const UWorld* World
+#endif // TAUT_ROPE_DEBUG_DRAWING
+	);
+	int32 GetNumSubsteps(
+		const FVector& StartLocation
+		, const FVector& EndLocation
+	) const;
 	TArray<FVector> MovementPhase(
 		const FVector& StartLocation
 		, const FVector& EndLocation
 		, const float MaxLength
 	);
+	// Returns true once CollisionSolve has converged or reached TAUT_ROPE_MAX_COLLISION_ITERATIONS.
 	bool CollisionPhase(
-		TArray<FVector>& TargetRopePoints
+		int32& InOutIterationBudget
+		, const double DeadlineSeconds
 #if TAUT_ROPE_DEBUG_DRAWING
 		, const UWorld* World
 #endif // TAUT_ROPE_DEBUG_DRAWING
@@ -49,6 +139,24 @@ private:
 #endif // TAUT_ROPE_DEBUG_DRAWING
 	);
 
+	// Rope point locations with the arcs around curved shapes, and the contact each location belongs to.
+	void BuildPath(TArray<FVector>& OutLocations, TArray<FIntVector>& OutFeatures) const;
+	// Refreshes the path views and arc lengths, returns true if the path changed.
+	bool RefreshPath(const float MaxLength);
+	void BroadcastContactChanges();
+	// Index of the path segment that contains Distance, clamped to the ends of the rope.
+	int32 FindArcSegment(const float Distance) const;
+
+	void CaptureRepro(
+		const TArray<TautRope::FPoint>& InputRopePoints
+		, const TArray<FTransform>& InputShapeTransforms
+		, const FVector& StartLocation
+		, const FVector& EndLocation
+		, const float MaxLength
+		, const float UpdateMs
+		, const TCHAR* Reason
+	) const;
+
 #if TAUT_ROPE_DEBUG_DRAWING
 	void DrawDebugRope(const UWorld* World) const;
 	void DrawDebugRopeTouchedShapeEdges(const UWorld* World) const;
@@ -56,4 +164,38 @@ private:
 
 	TArray<TautRope::FPoint> RopePoints;
 	TArray<FTautRopeCollisionShape> NearbyShapes;
+	// Per shape, parallel to NearbyShapes.
+	TArray<FBox> NearbyShapeBounds;
+	TArray<float> NearbyShapeMeanEdgeLengths;
+	// Parallel to the transient shapes at the end of NearbyShapes.
+	TArray<TautRope::FRopeSegment> ForeignSegments;
+
+	TautRope::FCollisionSolveState CollisionSolve;
+	TArray<FVector> ConsistentRopeLocations;
+	TArray<FIntVector> ConsistentRopeFeatures;
+
+	// Parallel arrays of the path the arc length queries run on.
+	TArray<FVector> PathLocations;
+	TArray<FIntVector> PathFeatures;
+	TArray<float> CumulativeArcLengths;
+	float ArcMaxLength = 0.f;
+	uint32 PathVersion = 0;
+
+	struct FContact
+	{
+		int32 ShapeIndex = INDEX_NONE;
+		int32 EdgeIndex = INDEX_NONE;
+		FVector Location = FVector::ZeroVector;
+
+		bool operator<(const FContact& Other) const
+		{
+			return ShapeIndex != Other.ShapeIndex ? ShapeIndex < Other.ShapeIndex : EdgeIndex < Other.EdgeIndex;
+		}
+	};
+	// Contacts of the last completed update, sorted by shape and edge.
+	TArray<FContact> Contacts;
+
+	TSharedPtr<TautRope::FRecording> ActiveRecording;
+	// Target transforms as of the last recorded frame, parallel to the recording's shapes.
+	TArray<FTransform> RecordedShapeTransforms;
 };
\ No newline at end of file
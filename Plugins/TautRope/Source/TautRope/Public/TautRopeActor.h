@@ -2,16 +2,23 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "TautRopeReplication.h"
+#include "TautRopeSegmentTree.h"
+#include "TautRopeSettings.h"
+#include "TautRopeSnapshot.h"
 #include "TautRopeActor.generated.h"
 
 class ATautRopeCollisionVolumeActor;
+class UTautRopeMeshComponent;
+class UTautRopeSubsystem;
 
 struct FTautRope;
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FTautRopeContactChangedSignature, FVector, Location);
+
 UCLASS(HideCategories = (
 	"Actor"
 	, "Input"
-	, "Replication"
 	, "Rendering"
 	, "HLOD"
 	, "Physics"
@@ -30,15 +37,82 @@ class TAUTROPE_API ATautRopeActor : public AActor
 public:
 	ATautRopeActor();
 
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	// Save games capture the rope's snapshot, and loading one into a running rope restores it.
+	virtual void Serialize(FArchive& Ar) override;
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
-	virtual void Tick(float DeltaTime) override;
-
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Taut Rope")
 	float MaxLength = 500.f;
 
+	// Use LODSettings instead of the project defaults.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Taut Rope|LOD")
+	bool bOverrideLODSettings = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Taut Rope|LOD", meta = (EditCondition = "bOverrideLODSettings"))
+	FTautRopeLODSettings LODSettings;
+
+	// Wraps over other colliding ropes that were spawned before this one, and lets later ones wrap over it.
+	// The rope mesh radius is the thickness of the rope.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Taut Rope|Rope Collision")
+	bool bCollidesWithRopes = false;
+
+	// Rope points for rendering, interpolated between simulation updates when the rope is updated at a reduced rate.
+	UFUNCTION(BlueprintPure, Category = "Taut Rope")
+	TArray<FVector> GetRopePoints() const { return PublishedRopePoints; }
+
+	// Arc length queries run on the latest simulated rope, which the published points trail while interpolating.
+	UFUNCTION(BlueprintPure, Category = "Taut Rope|Length")
+	float GetRopeLength() const;
+
+	// MaxLength minus the current rope length.
+	UFUNCTION(BlueprintPure, Category = "Taut Rope|Length")
+	float GetRopeSlack() const;
+
+	UFUNCTION(BlueprintPure, Category = "Taut Rope|Length")
+	FVector GetLocationAtDistance(float Distance) const;
+
+	UFUNCTION(BlueprintPure, Category = "Taut Rope|Length")
+	FVector GetTangentAtDistance(float Distance) const;
+
+	// Distance along the rope to the rope location closest to Location.
+	UFUNCTION(BlueprintPure, Category = "Taut Rope|Length")
+	float GetDistanceClosestToLocation(const FVector& Location) const;
+
+	UFUNCTION(BlueprintPure, Category = "Taut Rope|LOD")
+	ETautRopeUpdateLOD GetUpdateLOD() const { return UpdateLOD; }
+
+	// Increases whenever the simulated rope path changes.
+	UFUNCTION(BlueprintPure, Category = "Taut Rope")
+	int32 GetRopePathVersion() const;
+
+	UPROPERTY(BlueprintAssignable, Category = "Taut Rope")
+	FTautRopeContactChangedSignature OnContactAdded;
+
+	UPROPERTY(BlueprintAssignable, Category = "Taut Rope")
+	FTautRopeContactChangedSignature OnContactRemoved;
+
+	// Starts capturing the rope's shapes, points and per-frame inputs for offline replay.
+	UFUNCTION(BlueprintCallable, Category = "Taut Rope|Recording")
+	void StartRecording();
+
+	// Stops capturing and writes the recording to Saved/TautRope/Recordings. Returns the file path, empty on failure.
+	UFUNCTION(BlueprintCallable, Category = "Taut Rope|Recording")
+	FString StopRecording();
+
+#if WITH_EDITOR
+	// Settles the rope around its shapes and stores it with the level, so it starts wrapped instead of straight.
+	UFUNCTION(CallInEditor, Category = "Taut Rope|Snapshot")
+	void BakeRopeSnapshot();
+
+	UFUNCTION(CallInEditor, Category = "Taut Rope|Snapshot")
+	void ClearRopeSnapshot();
+#endif
+
 private:
 	UPROPERTY(VisibleAnywhere, Category = "Taut Rope")
 	USceneComponent* StartPoint;
@@ -46,6 +120,9 @@ private:
 	UPROPERTY(VisibleAnywhere, Category = "Taut Rope")
 	USceneComponent* EndPoint;
 
+	UPROPERTY(VisibleAnywhere, Category = "Taut Rope")
+	UTautRopeMeshComponent* RopeMesh;
+
 #if WITH_EDITORONLY_DATA
 	UPROPERTY()
 	class UBillboardComponent* StartPointBillboard;
@@ -54,5 +131,55 @@ private:
 	class UBillboardComponent* EndPointBillboard;
 #endif
 
+	// Rope updates are driven by UTautRopeSubsystem within its frame budget.
+	friend UTautRopeSubsystem;
+
+	void AdvanceSchedule(float DeltaTime);
+	ETautRopeUpdateLOD CalcUpdateLOD(bool& bOutIsOnScreen) const;
+	bool IsUpdateDue() const;
+	float GetUpdateImportance() const;
+	bool IsAttachedToPlayer() const;
+	void GatherNearbyShapes(FTautRope& Rope) const;
+	void AppendRopeSegments(
+		const int32 RopeId
+		, TArray<TautRope::FRopeSegment>& OutSegments
+	);
+	void UpdateForeignRopeSegments(
+		const TautRope::FRopeSegmentTree& SegmentTree
+		, const int32 RopeId
+	);
+	void UpdateSimulation();
+	void PublishRopePoints();
+	void HandleContactAdded(const int32 ShapeIndex, const FVector& Location);
+	void HandleContactRemoved(const int32 ShapeIndex, const FVector& Location);
+
 	FTautRope TautRope;
+
+	// Restored in BeginPlay when it still matches the shapes around the rope.
+	UPROPERTY(SaveGame)
+	FTautRopeSnapshot RopeSnapshot;
+
+	// Only the server simulates, clients place the replicated contacts on their own shapes.
+	UPROPERTY(Replicated)
+	FTautRopeReplicatedState ReplicatedState;
+
+	ETautRopeUpdateLOD UpdateLOD = ETautRopeUpdateLOD::Full;
+	bool bIsOnScreen = true;
+	float TimeSinceDisturbed = MAX_FLT;
+	FVector LastStartLocation = FVector::ZeroVector;
+	FVector LastEndLocation = FVector::ZeroVector;
+	int32 FramesSinceUpdate = 0;
+	float TimeSinceUpdate = 0.f;
+	float LastUpdateInterval = 0.f;
+	uint32 SolvedPathVersion = 0;
+	// The last update left the path as it was, so the previous solved points are stale.
+	bool bIsSolvedPathAtRest = false;
+	// This rope's segments as other ropes last saw them, kept while a collision solve is in progress.
+	TArray<TautRope::FRopeSegment> CachedRopeSegments;
+	TArray<FVector> PrevSolvedRopePoints;
+	TArray<FVector> SolvedRopePoints;
+	// Per solved rope point, the contact it belongs to as in FTautRope::GetRopeFeatures.
+	TArray<FIntVector> PrevSolvedRopeFeatures;
+	TArray<FIntVector> SolvedRopeFeatures;
+	TArray<FVector> PublishedRopePoints;
 };
\ No newline at end of file
@@ -5,7 +5,24 @@
 
 #include "TautRopeCollisionShape.generated.h"
 
+struct FKBoxElem;
 struct FKConvexElem;
+struct FKSphereElem;
+struct FKSphylElem;
+class USceneComponent;
+
+UENUM()
+enum class ETautRopeCollisionShapeType : uint8
+{
+	// Also one cell of the convex edges baked from a triangle mesh.
+	Convex,
+	// Stores only BoxExtent, the 12 edges and their adjacency are shared by every box.
+	Box,
+	// Curved shapes have no edges. The rope wraps them as an arc between an entry and an exit point.
+	Sphere,
+	// Radius around the segment of HalfLength along local Z.
+	Capsule,
+};
 
 USTRUCT()
 struct FTautRopeCollisionShapeVertEdges
@@ -14,8 +31,26 @@ struct FTautRopeCollisionShapeVertEdges
 
 	UPROPERTY()
 	TArray<int32> Edges;
+
+	friend FArchive& operator<<(FArchive& Ar, FTautRopeCollisionShapeVertEdges& VertEdges)
+	{
+		return Ar << VertEdges.Edges;
+	}
 };
 
+// Places a shared prototype shape, e.g. one instance of an instanced static mesh.
+USTRUCT()
+struct FTautRopeCollisionShapeInstance
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 PrototypeIndex = INDEX_NONE;
+
+	// Without scale, which is baked into the prototype.
+	UPROPERTY()
+	FTransform Transform;
+};
 
 USTRUCT()
 struct TAUTROPE_API FTautRopeCollisionShape
@@ -33,14 +68,136 @@ public:
 		, const UPrimitiveComponent* PrimComp
 		, const TArray<UPrimitiveComponent*>& OtherPrimComps
 	);
+	// An instance placed at InTransform that shares the geometry of InPrototype.
+	FTautRopeCollisionShape(
+		const TSharedRef<const FTautRopeCollisionShape>& InPrototype
+		, const FTransform& InTransform
+	);
+	// Bakes the convex in the component's local space so the shape can follow the component as it moves.
+	FTautRopeCollisionShape(
+		const FKConvexElem& Convex
+		, USceneComponent* InOwningComponent
+	);
+	FTautRopeCollisionShape(
+		const FKBoxElem& Box
+		, const FTransform& CompTransform
+	);
+	FTautRopeCollisionShape(
+		const FKBoxElem& Box
+		, USceneComponent* InOwningComponent
+	);
+	FTautRopeCollisionShape(
+		const FKSphereElem& Sphere
+		, const FTransform& CompTransform
+	);
+	FTautRopeCollisionShape(
+		const FKSphereElem& Sphere
+		, USceneComponent* InOwningComponent
+	);
+	FTautRopeCollisionShape(
+		const FKSphylElem& Capsule
+		, const FTransform& CompTransform
+	);
+	FTautRopeCollisionShape(
+		const FKSphylElem& Capsule
+		, USceneComponent* InOwningComponent
+	);
+
+	// Bakes the convex feature edges of a triangle mesh, e.g. complex collision, into world space shapes. Edges on flat or
+	// concave regions are dropped and the rest are grouped by cell of TAUT_ROPE_MESH_EDGE_CELL_SIZE, one shape per cell.
+	static void AppendTriangleMeshShapes(
+		TConstArrayView<FVector3f> MeshVertices
+		, TConstArrayView<FIntVector> MeshTriangles
+		, const FTransform& CompTransform
+		, TArray<FTautRopeCollisionShape>& OutShapes
+	);
+
+	FORCEINLINE bool IsCurved() const
+	{
+		return Type == ETautRopeCollisionShapeType::Sphere || Type == ETautRopeCollisionShapeType::Capsule;
+	}
+
+	// The shape holding Vertices, Edges, VertToEdges and EdgeRotations, which is the prototype for instances.
+	// For boxes this is the shared unit box topology, see GetLocalVertex.
+	FORCEINLINE const FTautRopeCollisionShape& GetGeometry() const
+	{
+		if (Type == ETautRopeCollisionShapeType::Box)
+		{
+			return GetBoxTopology();
+		}
+		return Prototype.IsValid() ? *Prototype : *this;
+	}
 
 	// If a vertex has more than one adjacent edge. 
 	// OBS: VertexIndex is asumed to be in valid range of Vertices array.
 	FORCEINLINE bool IsCornerVertex(const int32 VertexIndex) const
 	{
-		return IsCornerVertexList[VertexIndex];
+		return GetGeometry().IsCornerVertexList[VertexIndex];
 	};
 
+	FBox CalcBounds() const;
+
+	// In the space of Transform for local space shapes.
+	FORCEINLINE FVector GetLocalVertex(const int32 VertexIndex) const
+	{
+		const FVector& Vertex = GetGeometry().Vertices[VertexIndex];
+		return Type == ETautRopeCollisionShapeType::Box ? Vertex * BoxExtent : Vertex;
+	}
+
+	FORCEINLINE FVector GetVertex(const int32 VertexIndex) const
+	{
+		const FVector Vertex = GetLocalVertex(VertexIndex);
+		return bIsLocalSpace ? Transform.TransformPositionNoScale(Vertex) : Vertex;
+	}
+
+	FORCEINLINE FQuat GetEdgeRotation(const int32 EdgeIndex) const
+	{
+		const FQuat& EdgeRotation = GetGeometry().EdgeRotations[EdgeIndex];
+		return bIsLocalSpace ? Transform.GetRotation() * EdgeRotation : EdgeRotation;
+	}
+
+	// Carries a location on the shape from PrevTransform to Transform.
+	FORCEINLINE FVector MoveWithShape(const FVector& PrevLocation) const
+	{
+		return bIsLocalSpace ? Transform.TransformPositionNoScale(PrevTransform.InverseTransformPositionNoScale(PrevLocation)) : PrevLocation;
+	}
+
+	// Carries a location on the shape from Transform back to PrevTransform.
+	FORCEINLINE FVector MoveBackWithShape(const FVector& Location) const
+	{
+		return bIsLocalSpace ? PrevTransform.TransformPositionNoScale(Transform.InverseTransformPositionNoScale(Location)) : Location;
+	}
+
+	// Pulls TargetTransform from the owning component, if it is still around.
+	void RefreshTargetTransform();
+
+	// The shape holding KernelOrigin, KernelEdgeVertices, EdgeBoxes and the edge grid, which instances share with their prototype.
+	FORCEINLINE const FTautRopeCollisionShape& GetKernelShape() const
+	{
+		return Prototype.IsValid() ? *Prototype : *this;
+	}
+
+	// Fills KernelOrigin and KernelEdgeVertices for the single precision sweep kernel. Instances use their prototype's,
+	// which is built once before it is shared.
+	void BuildKernelEdges();
+
+	// Fills EdgeBounds, so edge sweeps can skip shapes they do not reach.
+	void BuildEdgeBounds();
+
+	// Fills EdgeBoxes, and the edge grid for shapes with many edges. Instances use their prototype's, like the kernel.
+	void BuildEdgeGrid();
+
+	// Whether an edge not in IgnoredEdges has bounds overlapping Box, in the space of GetLocalVertex.
+	bool IsAnyEdgeOverlapping(
+		const FBox& Box
+		, const TBitArray<>& IgnoredEdges
+	) const;
+
+	// Tells the same baked shape apart from others on every machine, whatever order the shapes were gathered in.
+	// Identical shapes on components with the same path in their level, e.g. in two copies of a sublevel, share a signature.
+	uint32 CalcSignature() const;
+
+	// World space for static shapes, the space of Transform for local space shapes.
 	UPROPERTY()
 	TArray<FVector> Vertices;
 
@@ -53,10 +210,79 @@ public:
 	UPROPERTY()
 	TArray<FQuat> EdgeRotations;
 
+	UPROPERTY()
+	ETautRopeCollisionShapeType Type = ETautRopeCollisionShapeType::Convex;
+
+	// Half size of a box, which is centered on Transform.
+	UPROPERTY()
+	FVector BoxExtent = FVector::ZeroVector;
+
+	UPROPERTY()
+	float Radius = 0.f;
+
+	UPROPERTY()
+	float HalfLength = 0.f;
+
+	UPROPERTY()
+	bool bIsLocalSpace = false;
+
+	UPROPERTY()
+	TWeakObjectPtr<USceneComponent> OwningComponent;
+
+	// Pose of the shape relative to OwningComponent.
+	UPROPERTY()
+	FTransform OwningComponentOffset;
+
+	// Pose the rope was last solved against. Scale is baked into Vertices.
+	UPROPERTY()
+	FTransform Transform;
+
+	// Set for instances, whose own geometry arrays stay empty.
+	TSharedPtr<const FTautRopeCollisionShape> Prototype;
+
+	// Pose at the start of the current rope step, for relative motion sweeps.
+	FTransform PrevTransform;
+
+	// Pose the shape should reach by the end of the next rope update.
+	FTransform TargetTransform;
+
+	// Edge end points relative to KernelOrigin, two per edge, in the space of GetLocalVertex. Built at runtime.
+	TArray<FVector3f> KernelEdgeVertices;
+	FVector KernelOrigin = FVector::ZeroVector;
+
+	// Bounds of the edges in the space of GetLocalVertex. Built at runtime, left invalid for boxes and curved shapes.
+	FBox EdgeBounds = FBox(ForceInit);
+
+	// Bounds of each edge in the space of GetLocalVertex. Built at runtime, empty for curved shapes.
+	TArray<FBox> EdgeBoxes;
+
+	// Edge indices bucketed by the grid cells their EdgeBoxes overlap, the edges of cell i are
+	// EdgeGridEdges[EdgeGridCellStarts[i]] up to EdgeGridEdges[EdgeGridCellStarts[i + 1]]. Built at runtime, empty for
+	// shapes with fewer than TAUT_ROPE_EDGE_GRID_MIN_EDGES edges.
+	TArray<int32> EdgeGridCellStarts;
+	TArray<int32> EdgeGridEdges;
+	FVector EdgeGridOrigin = FVector::ZeroVector;
+	FIntVector EdgeGridDims = FIntVector::ZeroValue;
+	double EdgeGridCellSize = 0.;
+
+	// Stands in for a segment of another rope. Rebuilt every update and left out of saved and replicated rope states.
+	bool bIsTransient = false;
+
+	// Compact untagged serialization, used for recordings rather than asset saving.
+	friend FArchive& operator<<(FArchive& Ar, FTautRopeCollisionShape& Shape);
+
 private:
 	UPROPERTY()
 	TArray<bool> IsCornerVertexList;
 
+	static const FTautRopeCollisionShape& GetBoxTopology();
+
+	// The edge grid cell holding LocalLocation, clamped into the grid.
+	FIntVector GetEdgeGridCell(const FVector& LocalLocation) const;
+
+	// Shapes baked with only the component scale become relative to the component and follow it.
+	void AttachToOwningComponent(USceneComponent* InOwningComponent);
+
 
 	void MakeInitialHitResults(
 		FHitResult& InitHitResultA
@@ -20,6 +20,7 @@ public:
 	ATautRopeCollisionVolumeActor();
 
 protected:
+	virtual void PostInitializeComponents() override;
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 #if TAUT_ROPE_DEBUG_DRAWING
@@ -34,11 +35,21 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "Taut Rope Collision")
 	TObjectPtr<UBoxComponent> CollisionVolume;
 
+	// Static meshes that use complex collision as simple are baked from their collision triangles, keeping only convex edges
+	UPROPERTY(EditAnywhere, Category = "Taut Rope Collision")
+	bool bBakeComplexCollision = true;
+
 	/** Returns a const view of the static rope collision shapes found within the collision volume */
 	TConstArrayView<FTautRopeCollisionShape> GetStaticShapes() const { return StaticShapes; }
 
+	/** Returns a const view of the rope collision shapes that follow movable primitives within the collision volume */
+	TConstArrayView<FTautRopeCollisionShape> GetMovableShapes() const { return MovableShapes; }
+
+	/** Returns a const view of the instanced rope collision shapes, which share the geometry of their prototype */
+	TConstArrayView<FTautRopeCollisionShape> GetInstanceShapes() const { return InstanceShapes; }
+
 #if WITH_EDITOR
-	// Expose a button in the details panel to populate StaticShapes from simple collision of primitives within the collision volume
+	// Expose a button in the details panel to populate StaticShapes and MovableShapes from simple collision of primitives within the collision volume
 	UFUNCTION(CallInEditor, Category = "Taut Rope Collision")
 	void PopulateStaticShapes();
 #endif
@@ -47,4 +58,20 @@ private:
 	// Stored data from simple collision of primitives within the collision volume
 	UPROPERTY()
 	TArray<FTautRopeCollisionShape> StaticShapes;
+
+	// Stored in the local space of movable primitives, posed at runtime from their component transforms
+	UPROPERTY()
+	TArray<FTautRopeCollisionShape> MovableShapes;
+
+	// Baked once per unique mesh and scale of instanced static mesh components, in local space
+	UPROPERTY()
+	TArray<FTautRopeCollisionShape> ShapePrototypes;
+
+	UPROPERTY()
+	TArray<FTautRopeCollisionShapeInstance> ShapeInstances;
+
+	// Runtime shapes for ShapeInstances, sharing one geometry per prototype
+	TArray<FTautRopeCollisionShape> InstanceShapes;
+
+	void BuildInstanceShapes();
 };
@@ -4,8 +4,44 @@
 #define TAUT_ROPE_VERTEX_CROSSING_OFFSET				(0.1f)
 #define TAUT_ROPE_SHAPE_MERGE_VERTEX_THRESHOLD			(0.1f)
 #define TAUT_ROPE_SHAPE_EDGE_RAY_INCREMENT_DISTANCE		(1.f)
+// Hull edges whose two triangle normals are closer than this, about 0.8 degrees, are dropped when baking a convex.
+#define TAUT_ROPE_SHAPE_COPLANAR_NORMAL_DOT				(0.9999f)
 
 #define TAUT_ROPE_MAX_COLLISION_ITERATIONS				(100)
+#define TAUT_ROPE_MAX_CHAIN_TIGHTENING_ITERATIONS		(32)
+
+// Received rope states a client keeps for the server to send deltas against.
+#define TAUT_ROPE_NET_STATE_HISTORY						(16)
+
+// Rope updates run in the editor to settle a rope before its snapshot is captured.
+#define TAUT_ROPE_SNAPSHOT_BAKE_MAX_UPDATES				(64)
+
+#define TAUT_ROPE_SEGMENT_TREE_LEAF_SIZE				(4)
+#define TAUT_ROPE_SEGMENT_TREE_MAX_REFITS				(30)
+
+// Convex edges baked from triangle meshes are grouped into one shape per cell of this size.
+#define TAUT_ROPE_MESH_EDGE_CELL_SIZE					(500.f)
+
+// Shapes with at least this many edges bucket them into a grid of cells about as large as their mean edge, capped per axis.
+#define TAUT_ROPE_EDGE_GRID_MIN_EDGES					(64)
+#define TAUT_ROPE_EDGE_GRID_MAX_CELLS_PER_AXIS			(16)
+
+// Rope mesh rings whose carried rotation moves less than this end the rebuild of the rings after a changed span.
+#define TAUT_ROPE_MESH_RING_ROTATION_TOLERANCE			(1.e-4f)
+
+// Edge sweeps run in single precision on shape geometry stored as floats around a per shape origin.
+// Float rounding is at most 2^-24 of a coordinate per operation and the intersection takes about 16 rounding steps, which
+// the division by the determinant scales by the product of its operand lengths over the determinant. Coordinates up to
+// TAUT_ROPE_FLOAT_KERNEL_MAX_EXTENT, with a determinant of at least TAUT_ROPE_FLOAT_KERNEL_MIN_RELATIVE_DET of that
+// product, keep the error at half of TAUT_ROPE_DISTANCE_TOLERANCE: 2^-24 * 16 * 1000 cm / 0.2 ~ 0.005 cm.
+// Other sweeps run in double precision.
+#define TAUT_ROPE_FLOAT_SWEEP_KERNEL					(1)
+#define TAUT_ROPE_FLOAT_KERNEL_MAX_EXTENT				(1000.f)
+#define TAUT_ROPE_FLOAT_KERNEL_MIN_RELATIVE_DET			(0.2f)
+
+// Curved sweeps bisect until the touching alpha is within TAUT_ROPE_DISTANCE_TOLERANCE along the sweep, at most this often.
+#define TAUT_ROPE_CURVED_SWEEP_BISECTIONS				(24)
+#define TAUT_ROPE_CURVED_ARC_STEP_RADIANS				(0.26f)
 
 #define TAUT_ROPE_DISTANCE_TOLERANCE_SQUARED			(TAUT_ROPE_DISTANCE_TOLERANCE * TAUT_ROPE_DISTANCE_TOLERANCE)
 #define TAUT_ROPE_SHAPE_MERGE_VERTEX_THRESHOLD_SQUARED	(TAUT_ROPE_SHAPE_MERGE_VERTEX_THRESHOLD * TAUT_ROPE_SHAPE_MERGE_VERTEX_THRESHOLD)
@@ -16,6 +16,31 @@ namespace TautRope
 		int32 ShapeIndex = INDEX_NONE;
 		int32 EdgeIndex = INDEX_NONE;
 		float SweepRatio = MAX_FLT;
+		// Set for hits chained after the first, see SweepSegmentThroughShapes.
+		bool bIsChained = false;
+		// Where the moving corner was when the rope bent around the hit before this one in the chain.
+		FVector ChainOriginLocation = FVector::ZeroVector;
+	};
+
+	// Collision phase state that persists across updates while a solve is spread over several frames.
+	struct TAUTROPE_API FCollisionSolveState
+	{
+		bool bIsActive = false;
+		int32 Iterations = 0;
+		TArray<FVector> OriginRopePoints;
+		TArray<FVector> TargetRopePoints;
+		// Segments that still need a sweep, indexed by the segment's first rope point.
+		TBitArray<> PendingSegments;
+	};
+
+	// Edges around a segment's contacts on the shape both its points touch, for sweeps that stay near them.
+	// Only built when no other edge of the shape reaches into Bounds.
+	struct TAUTROPE_API FLocalEdgeSearch
+	{
+		int32 ShapeIndex = INDEX_NONE;
+		TArray<int32> EdgeIndices;
+		// In the space of GetLocalVertex, grown by TAUT_ROPE_DISTANCE_TOLERANCE.
+		FBox Bounds = FBox(ForceInit);
 	};
 
 	struct FPoint;
@@ -31,8 +56,27 @@ namespace TautRope
 #endif
 	);
 
+	// Removes the contiguous points from FirstRemovePointIndex to LastRemovePointIndex. Clear fans of the run are removed in
+	// a single sweep over the shapes whose ShapeBounds touch it, the points from the first hit on fall back to SweepRemovePoint.
+	void SweepRemovePoints(
+		TArray<FPoint>& RopePoints
+		, const int32 FirstRemovePointIndex
+		, const int32 LastRemovePointIndex
+		, const TArray<FTautRopeCollisionShape>& Shapes
+		, const TArray<FBox>& ShapeBounds
+#if TAUT_ROPE_DEBUG_DRAWING
+		, const UWorld* World = nullptr
+		, const bool bIsDebugDrawingActive = false
+#endif
+	);
+
+	// OutHitChain holds the earliest hit and, up to MaxChainHits, the hits the rope still sweeps into once bent around it.
+	// They are in rope order, to be inserted in front of RopePointIndex. Chained hits are only found among world space
+	// edges, so the segments between them have to be swept again against every shape, from their ChainOriginLocation.
+	// When both points touch the same shape, a sweep that stays around them only tests that shape's edges within
+	// LocalSearchHops steps along VertToEdges of their edges.
 	void SweepSegmentThroughShapes(
-		FHitData& OutHitData
+		TArray<FHitData>& OutHitChain
 		, FPoint& InOutSegmentPointA
 		, FPoint& InOutSegmentPointB
 		, const FVector& OriginLocationA
@@ -41,6 +85,8 @@ namespace TautRope
 		, const FVector& TargetLocationB
 		, const TArray<FTautRopeCollisionShape>& Shapes
 		, const int32 RopePointIndex
+		, const int32 MaxChainHits
+		, const int32 LocalSearchHops
 #if TAUT_ROPE_DEBUG_DRAWING
 		, const UWorld* World
 		, const bool bIsDebugDrawingActive
@@ -61,7 +107,10 @@ namespace TautRope
 		const int32 VertIndexPointB,
 		const int32 RopePointIndex,
 		const bool bIsFirstTriangleSweep,
-		FHitData& OutHitData
+		FHitData& OutHitData,
+		// Collects every edge hit of world space shapes, not only the earliest.
+		TArray<FHitData>* OutAllHits = nullptr,
+		const FLocalEdgeSearch* LocalEdgeSearch = nullptr
 	);
 	void SweepRemoveTriangleAgainstShape(
 		const FVector& FromCorner
@@ -72,14 +121,25 @@ namespace TautRope
 		, const TArray<FIntVector2>& IgnoredEdges
 		, FHitData& OutHitData
 	);
-	bool GetTriangleLineIntersection(
-		const FVector& FromCorner
-		, const FVector& ToCorner
-		, const FVector& SupportCorner
-		, const FVector& LineA
-		, const FVector& LineB
-		, FVector& OutLocation
-		, FVector& OutOnSweepEdgeLocation
+	enum class ETriangleLineIntersection : uint8
+	{
+		None,
+		Hit,
+		// Too close to parallel for single precision, see TAUT_ROPE_FLOAT_KERNEL_MIN_RELATIVE_DET.
+		IllConditioned,
+	};
+
+	// Instantiated for double and float. The float one is the sweep kernel for shapes with KernelEdgeVertices, and is the
+	// only one that returns IllConditioned.
+	template<typename FReal>
+	ETriangleLineIntersection GetTriangleLineIntersection(
+		const UE::Math::TVector<FReal>& FromCorner
+		, const UE::Math::TVector<FReal>& ToCorner
+		, const UE::Math::TVector<FReal>& SupportCorner
+		, const UE::Math::TVector<FReal>& LineA
+		, const UE::Math::TVector<FReal>& LineB
+		, UE::Math::TVector<FReal>& OutLocation
+		, UE::Math::TVector<FReal>& OutOnSweepEdgeLocation
 		, float& OutSweepRatio
 	);
 
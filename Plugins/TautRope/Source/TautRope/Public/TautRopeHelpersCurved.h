@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TautRopeCollisionShape.h"
+
+namespace TautRope
+{
+	struct FPoint;
+
+	// If the segment from PointIndex to the next point is an arc around a curved shape, between its entry and exit point.
+	bool IsCurvedWrapSegment(
+		const TArray<FPoint>& RopePoints
+		, const int32 PointIndex
+		, const TArray<FTautRopeCollisionShape>& Shapes
+	);
+
+	// Length of the rope between PointIndex and the next point, following the arc around curved shapes.
+	float GetRopeSegmentLength(
+		const TArray<FPoint>& RopePoints
+		, const int32 PointIndex
+		, const TArray<FTautRopeCollisionShape>& Shapes
+	);
+
+	// Closest point of the shape's core, its center or capsule axis, to the segment AB. All in the shape's frame.
+	FVector GetClosestCurvedCorePoint(
+		const FTautRopeCollisionShape& Shape
+		, const FVector& LocalA
+		, const FVector& LocalB
+		, FVector& OutClosestOnSegment
+	);
+
+	bool IsSegmentClearOfCurvedShape(
+		const FVector& A
+		, const FVector& B
+		, const FTautRopeCollisionShape& Shape
+	);
+
+	// Finds where the corner moving From -> To first brings the segment to Support onto the shape. All in the shape's frame.
+	// Exact up to the bisection tolerance, as the distance from the swept triangle to the core is computed analytically.
+	bool SweepTriangleAgainstCurvedShape(
+		const FVector& FromCorner
+		, const FVector& ToCorner
+		, const FVector& SupportCorner
+		, const FTautRopeCollisionShape& Shape
+		, FVector& OutContactLocation
+		, FVector& OutOnSweepEdgeLocation
+		, float& OutSweepAlpha
+	);
+
+	// Tangent entry and exit points of the shortest wrap from A to C, on the side the rope currently wraps.
+	// Capsules are wrapped as the sphere around the axis point closest to AC, which is exact for wraps across the axis.
+	void SolveCurvedWrap(
+		const FTautRopeCollisionShape& Shape
+		, const FVector& A
+		, const FVector& C
+		, const FVector& Entry
+		, const FVector& Exit
+		, FVector& OutEntry
+		, FVector& OutExit
+	);
+
+	// Length of the arc from entry to exit, running around the shape the way the rope arrives from Before.
+	// Wraps of more than half a turn are kept.
+	float GetCurvedWrapLength(
+		const FTautRopeCollisionShape& Shape
+		, const FVector& Before
+		, const FVector& Entry
+		, const FVector& Exit
+	);
+
+	// Adds the locations strictly between entry and exit along the arc, running the way the rope arrives from Before.
+	void AppendCurvedWrapLocations(
+		const FTautRopeCollisionShape& Shape
+		, const FVector& Before
+		, const FVector& Entry
+		, const FVector& Exit
+		, TArray<FVector>& InOutLocations
+	);
+}
\ No newline at end of file
@@ -5,6 +5,7 @@
 
 namespace TautRope
 {
+	// Consecutive rope points on edges that all share VertIndex, which can be straightened together.
 	struct FMovementGroup
 	{
 		FMovementGroup(
@@ -19,6 +20,14 @@ namespace TautRope
 		TArray<int32> EdgeIndices;
 	};
 
+	// Consecutive rope points on edges of the same shape, tightened together in one solve.
+	struct FContactChain
+	{
+		int32 ShapeIndex = INDEX_NONE;
+		int32 FirstPointIndex = INDEX_NONE;
+		int32 LastPointIndex = INDEX_NONE;
+	};
+
 	struct FPoint;
 
 	TArray<FMovementGroup> GetMovementGroups(
@@ -26,11 +35,41 @@ namespace TautRope
 		, const TArray<FTautRopeCollisionShape>& NearbyShapes
 	);
 
+	// Places the group's points where the straight line from A to C crosses the unfolded fan.
+	// Returns false if that line leaves the fan, e.g. over the shared vertex.
+	bool SolveMovementGroup(
+		const FMovementGroup& Group
+		, const FTautRopeCollisionShape& Shape
+		, const FVector& A
+		, const FVector& C
+		, TArray<FVector>& InOutTargetLocations
+	);
+
+	TArray<FContactChain> GetContactChains(
+		const TArray<FPoint>& RopePoints
+		, const TArray<FTautRopeCollisionShape>& NearbyShapes
+	);
+
+	// Moves the chain's targets onto the shortest path through its edges between the targets on either side.
+	void SolveContactChain(
+		const FContactChain& Chain
+		, const TArray<FPoint>& RopePoints
+		, const FTautRopeCollisionShape& Shape
+		, TArray<FVector>& InOutTargetLocations
+	);
+
 	TArray<int32> GetCandidateVerts(
 		const FPoint& P,
 		const FTautRopeCollisionShape& Shape
 	);
 
+	// Where a point crossing the vertex VertIndex at the end of EdgeIndex is placed, just off the vertex.
+	FVector GetVertexCrossingLocation(
+		const FTautRopeCollisionShape& Shape
+		, const int32 EdgeIndex
+		, const int32 VertIndex
+	);
+
 	FVector FindMinDistancePointBetweenABOnLineXY(
 		const FVector& A
 		, const FVector& B
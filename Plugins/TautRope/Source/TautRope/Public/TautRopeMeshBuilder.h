@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DynamicMeshBuilder.h"
+
+namespace TautRope
+{
+	struct FMeshSettings
+	{
+		float Radius = 2.f;
+		int32 NumSides = 8;
+		// Rings per interior rope point, spread over the rounded bend around it.
+		int32 NumBendRings = 4;
+		// How far along each adjacent segment a bend starts rounding off, at most half the segment.
+		float BendDistance = 4.f;
+
+		bool operator==(const FMeshSettings& Other) const = default;
+	};
+
+	/**
+	 * Builds an open tube along the rope, with rounded bends at the interior points.
+	 * Every rope point owns a fixed number of rings, so a changed rope point only rebuilds the rings around it,
+	 * and the rings after it that its twist carries over to, and the vertices keep their place between updates
+	 * as long as the number of rope points stays the same.
+	 */
+	class TAUTROPE_API FMeshBuilder
+	{
+	public:
+		// Half-open range of vertices that changed in the last Update.
+		struct FDirtyRange
+		{
+			int32 FirstVertex = 0;
+			int32 EndVertex = 0;
+
+			bool IsEmpty() const { return EndVertex <= FirstVertex; }
+		};
+
+		FDirtyRange Update(
+			const TConstArrayView<FVector> Points
+			, const FMeshSettings& InSettings
+		);
+
+		// Ring to ring triangles for a tube of up to NumRings rings.
+		void BuildIndices(
+			const int32 NumRings
+			, TArray<uint32>& OutIndices
+		) const;
+
+		const TArray<FDynamicMeshVertex>& GetVertices() const { return Vertices; }
+		int32 GetNumRings() const { return RingCenters.Num(); }
+		int32 GetNumVerticesPerRing() const { return Settings.NumSides + 1; }
+		const FBox& GetBounds() const { return Bounds; }
+
+	private:
+		int32 GetFirstRingIndex(const int32 PointIndex) const;
+		int32 CalcNumRings(const int32 NumPoints) const;
+		int32 GetNumPointRings(const int32 PointIndex) const;
+		// Places the centers and directions of the rings of a rope point.
+		void BuildPointRings(const int32 PointIndex);
+		// Carries the previous ring's rotation onto the ring's direction, a rotation minimizing frame along the tube.
+		void UpdateRingRotation(
+			const int32 RingIndex
+			, const FQuat* PrevFirstRotation
+		);
+		void BuildRingVertices(const int32 RingIndex);
+
+		FMeshSettings Settings;
+		TArray<FVector> Points;
+		TArray<FVector> RingCenters;
+		TArray<FVector> RingDirections;
+		// Rotation from the X axis onto each ring, with the ring's sides around X.
+		TArray<FQuat> RingRotations;
+		// Distance along the tube to each ring, used for the texture coordinates along the rope.
+		TArray<float> RingArcLengths;
+		TArray<FDynamicMeshVertex> Vertices;
+		FBox Bounds = FBox(ForceInit);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/MeshComponent.h"
+#include "TautRopeMeshBuilder.h"
+#include "TautRopeMeshComponent.generated.h"
+
+/**
+ * Renders a rope as a tube. Only the vertices of rope spans that changed since the last SetRopePoints
+ * are rebuilt and uploaded, into buffers that are kept between updates and grow when the rope gets more points.
+ * Rope points are in world space, so the component ignores its parent's transform.
+ */
+UCLASS(ClassGroup = Rendering, meta = (BlueprintSpawnableComponent))
+class TAUTROPE_API UTautRopeMeshComponent : public UMeshComponent
+{
+	GENERATED_BODY()
+
+public:
+	UTautRopeMeshComponent();
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Taut Rope Mesh", meta = (ClampMin = "0.01"))
+	float Radius = 2.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Taut Rope Mesh", meta = (ClampMin = "3", ClampMax = "32"))
+	int32 NumSides = 8;
+
+	// Rings spent on the rounded bend at every rope point between the two ends.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Taut Rope Mesh", meta = (ClampMin = "1", ClampMax = "16"))
+	int32 NumBendRings = 4;
+
+	// How far along the adjacent spans a bend starts rounding off.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Taut Rope Mesh", meta = (ClampMin = "0"))
+	float BendDistance = 4.f;
+
+	UFUNCTION(BlueprintCallable, Category = "Taut Rope Mesh")
+	void SetRopePoints(const TArray<FVector>& Points);
+
+	virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
+	virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const override;
+	virtual int32 GetNumMaterials() const override { return 1; }
+
+protected:
+	virtual void SendRenderDynamicData_Concurrent() override;
+
+private:
+	TautRope::FMeshBuilder MeshBuilder;
+	// Vertices changed since the scene proxy was last updated.
+	TautRope::FMeshBuilder::FDirtyRange PendingDirtyRange;
+	// Rings the scene proxy's buffers have room for.
+	int32 ProxyRingCapacity = 0;
+};
\ No newline at end of file
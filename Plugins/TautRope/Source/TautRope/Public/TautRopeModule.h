@@ -4,6 +4,10 @@
 
 #include "Modules/ModuleManager.h"
 
+TAUTROPE_API DECLARE_LOG_CATEGORY_EXTERN(LogTautRope, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("TautRope"), STATGROUP_TautRope, STATCAT_Advanced);
+
 class FTautRopeModule : public IModuleInterface
 {
 public:
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TautRopeCollisionShape.h"
+#include "TautRopePoint.h"
+
+namespace TautRope
+{
+	/**
+	 * A rope point between the endpoints, stored as the shape feature it rests on instead of a location.
+	 * 12 bytes against FPoint's 36, and the same bits on every machine for the same rope.
+	 */
+	struct TAUTROPE_API FPackedPoint
+	{
+		int32 ShapeIndex = INDEX_NONE;
+		// The edge index above a vertex crossing bit, or CurvedBit and the position along a capsule's axis.
+		uint32 FeatureBits = 0;
+		// Edges: the distance along the edge from its first vertex, over the full range. Crossings use 0 or the maximum
+		// for the end they cross. Curved shapes: the direction from the axis, octahedral encoded.
+		uint32 Param = 0;
+
+		static constexpr uint32 CurvedBit = 1u << 31;
+		static constexpr uint32 VertexCrossingBit = 1u;
+
+		bool IsCurved() const { return (FeatureBits & CurvedBit) != 0; }
+		bool IsVertexCrossing() const { return !IsCurved() && (FeatureBits & VertexCrossingBit) != 0; }
+		int32 GetEdgeIndex() const { return IsCurved() ? INDEX_NONE : static_cast<int32>(FeatureBits >> 1); }
+
+		bool operator==(const FPackedPoint& Other) const = default;
+
+		friend FArchive& operator<<(FArchive& Ar, FPackedPoint& Point)
+		{
+			return Ar << Point.ShapeIndex << Point.FeatureBits << Point.Param;
+		}
+	};
+
+	// A whole rope, with full locations only for its two free endpoints.
+	struct TAUTROPE_API FPackedRopeState
+	{
+		FVector StartLocation = FVector::ZeroVector;
+		FVector EndLocation = FVector::ZeroVector;
+		TArray<FPackedPoint> Points;
+
+		friend FArchive& operator<<(FArchive& Ar, FPackedRopeState& State)
+		{
+			return Ar << State.StartLocation << State.EndLocation << State.Points;
+		}
+	};
+
+	FPackedPoint PackPoint(
+		const FPoint& Point
+		, const TArray<FTautRopeCollisionShape>& Shapes
+	);
+
+	// Returns a point without a shape if the packed point does not fit the shapes.
+	FPoint UnpackPoint(
+		const FPackedPoint& Point
+		, const TArray<FTautRopeCollisionShape>& Shapes
+	);
+
+	TAUTROPE_API FPackedRopeState PackRopePoints(
+		const TArray<FPoint>& RopePoints
+		, const TArray<FTautRopeCollisionShape>& Shapes
+	);
+
+	// Points that do not fit the shapes are dropped, the rope goes straight past them.
+	TAUTROPE_API TArray<FPoint> UnpackRopePoints(
+		const FPackedRopeState& State
+		, const TArray<FTautRopeCollisionShape>& Shapes
+	);
+
+	// World locations of the whole rope, for callers that keep a hot location array next to the packed state.
+	TAUTROPE_API void GetPackedRopeLocations(
+		const FPackedRopeState& State
+		, const TArray<FTautRopeCollisionShape>& Shapes
+		, TArray<FVector>& OutLocations
+	);
+}
\ No newline at end of file
@@ -8,11 +8,17 @@ namespace TautRope
 
 	struct TAUTROPE_API FPoint
 	{
+		FPoint() = default;
 		FPoint(const FVector& InLocation);
 		FPoint(const FHitData& HitData);
 		FVector Location = FVector::ZeroVector;
 		int32 ShapeIndex = INDEX_NONE;
 		int32 EdgeIndex = INDEX_NONE;
 		int32 VertIndex = INDEX_NONE;
+
+		friend FArchive& operator<<(FArchive& Ar, FPoint& Point)
+		{
+			return Ar << Point.Location << Point.ShapeIndex << Point.EdgeIndex << Point.VertIndex;
+		}
 	};
 }
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TautRopeCollisionShape.h"
+#include "TautRopePoint.h"
+#include "TautRopeSegmentTree.h"
+
+namespace TautRope
+{
+	// Inputs of a single UpdateRope call.
+	struct TAUTROPE_API FRecordingFrame
+	{
+		FVector StartLocation = FVector::ZeroVector;
+		FVector EndLocation = FVector::ZeroVector;
+		float MaxLength = 0.f;
+		// Time the UpdateRope call took when it was recorded.
+		float RecordedMs = 0.f;
+		// Target transforms of the shapes that moved since the frame before, parallel to their shape indices. Shapes that
+		// never move are only stored once, with the transform in FRecording::Shapes.
+		TArray<int32> ShapeTransformIndices;
+		TArray<FTransform> ShapeTransforms;
+		// Segments of other ropes the rope wrapped over during the update, set before it like the rope's owner does.
+		TArray<FRopeSegment> ForeignSegments;
+
+		friend FArchive& operator<<(FArchive& Ar, FRecordingFrame& Frame)
+		{
+			return Ar << Frame.StartLocation << Frame.EndLocation << Frame.MaxLength << Frame.RecordedMs << Frame.ShapeTransformIndices << Frame.ShapeTransforms << Frame.ForeignSegments;
+		}
+	};
+
+	// Everything needed to re-run a sequence of UpdateRope calls in isolation.
+	struct TAUTROPE_API FRecording
+	{
+		// Shapes the rope gathered itself, without the capsules of foreign rope segments.
+		TArray<FTautRopeCollisionShape> Shapes;
+		TArray<FRopeSegment> InitialForeignSegments;
+		TArray<FPoint> InitialRopePoints;
+		TArray<FRecordingFrame> Frames;
+
+		void Serialize(FArchive& Ar);
+		bool SaveToFile(const FString& FilePath) const;
+		bool LoadFromFile(const FString& FilePath);
+	};
+
+	struct TAUTROPE_API FReplayFrameResult
+	{
+		double Ms = 0.0;
+		int32 NumRopePoints = 0;
+	};
+
+	// Re-runs the recorded frames on a fresh rope as fast as possible, timing each UpdateRope call.
+	TAUTROPE_API void ReplayRecording(
+		const FRecording& Recording
+		, TArray<FReplayFrameResult>& OutFrameResults
+	);
+
+	TAUTROPE_API void LogReplayResults(
+		const FString& Name
+		, const FRecording& Recording
+		, const TArray<FReplayFrameResult>& FrameResults
+	);
+
+	TAUTROPE_API bool SaveReplayResultsCsv(
+		const FString& FilePath
+		, const FRecording& Recording
+		, const TArray<FReplayFrameResult>& FrameResults
+	);
+
+	// Builds a single frame repro holding only the shapes the update could have touched.
+	TAUTROPE_API FRecording MakeFrameRepro(
+		const TArray<FTautRopeCollisionShape>& Shapes
+		, const TArray<FPoint>& RopePoints
+		, const FRecordingFrame& Frame
+	);
+
+	TAUTROPE_API FString GetRecordingsDir();
+	TAUTROPE_API FString GetReprosDir();
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TautRopeReplayCommandlet.generated.h"
+
+/**
+ * Headless replay of rope recordings for repeatable performance tests.
+ * Usage: -run=TautRopeReplay -File=<Recording> [-Repeat=<N>] [-Csv=<Output>]
+ */
+UCLASS()
+class UTautRopeReplayCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UTautRopeReplayCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
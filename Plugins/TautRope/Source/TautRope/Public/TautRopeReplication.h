@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/NetSerialization.h"
+#include "TautRopeCollisionShape.h"
+#include "TautRopePackedPoint.h"
+#include "TautRopePoint.h"
+
+#include "TautRopeReplication.generated.h"
+
+/**
+ * Replicates a rope as its quantized endpoints and contact list, each update sent as the contacts that changed
+ * since the state the receiving client last acknowledged. Clients place the contacts on their own baked shapes,
+ * found by shape signature since clients may gather the shapes in another order than the server. Contacts on shapes
+ * that share a signature go to the shape that keeps the rope shortest between its neighboring contacts.
+ * Contacts are packed points, with edge parameters cut to 16 bits on the wire. Contacts with other ropes are sent as
+ * locations, since rope ids and segment keys differ from machine to machine, and go to the closest capsule the client
+ * built for the other ropes' replicated paths.
+ */
+USTRUCT()
+struct TAUTROPE_API FTautRopeReplicatedState
+{
+	GENERATED_BODY()
+
+public:
+	// Server side, returns true if the state changed.
+	bool SetFromRopePoints(
+		const TArray<TautRope::FPoint>& RopePoints
+		, const TArray<FTautRopeCollisionShape>& Shapes
+	);
+
+	// Client side, returns true once per newly received state.
+	bool ConsumeReceivedState();
+	TArray<TautRope::FPoint> ToRopePoints(const TArray<FTautRopeCollisionShape>& Shapes) const;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms);
+
+	struct FContact
+	{
+		// Shape index on the server.
+		TautRope::FPackedPoint Point;
+		// FTautRopeCollisionShape::CalcSignature of the contact's shape.
+		uint32 ShapeSignature = 0;
+		// Contacts with other ropes only carry their location, at the precision it is sent with.
+		bool bIsOnRope = false;
+		FVector_NetQuantize10 RopeLocation = FVector::ZeroVector;
+
+		bool operator==(const FContact& Other) const = default;
+	};
+
+	struct FState
+	{
+		// Increases with every change on the server, 0 is no state.
+		uint32 StateId = 0;
+		FVector_NetQuantize10 StartLocation = FVector::ZeroVector;
+		FVector_NetQuantize10 EndLocation = FVector::ZeroVector;
+		TArray<FContact> Contacts;
+	};
+
+private:
+	FState State;
+	// States received by a client, which the server may still send deltas against until it learns of newer acks.
+	TArray<FState> ReceivedStates;
+	bool bHasReceivedState = false;
+};
+
+template<>
+struct TStructOpsTypeTraits<FTautRopeReplicatedState> : public TStructOpsTypeTraitsBase2<FTautRopeReplicatedState>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
\ No newline at end of file
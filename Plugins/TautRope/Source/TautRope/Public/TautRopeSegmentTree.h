@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TautRopeCollisionShape.h"
+#include "TautRopePoint.h"
+
+namespace TautRope
+{
+	// A straight piece of a rope between two of its points, which other ropes can wrap over.
+	struct TAUTROPE_API FRopeSegment
+	{
+		// Ropes only wrap over ropes with a lower id, so two ropes never push on each other.
+		int32 RopeId = INDEX_NONE;
+		// Stays the same while the segment runs between the same two rope features.
+		uint32 Key = 0;
+		FVector Start = FVector::ZeroVector;
+		FVector End = FVector::ZeroVector;
+		float Radius = 0.f;
+
+		friend FArchive& operator<<(FArchive& Ar, FRopeSegment& Segment)
+		{
+			return Ar << Segment.RopeId << Segment.Key << Segment.Start << Segment.End << Segment.Radius;
+		}
+	};
+
+	// Arcs around curved shapes are left out, they hug their shape.
+	TAUTROPE_API void AppendRopeSegments(
+		const TArray<FPoint>& RopePoints
+		, const TArray<FTautRopeCollisionShape>& Shapes
+		, const int32 RopeId
+		, const float Radius
+		, TArray<FRopeSegment>& OutSegments
+	);
+
+	/**
+	 * Bounding volume hierarchy over the segments of every rope in a world. UTautRopeSubsystem updates it once per
+	 * frame, so each rope only tests the foreign segments near it instead of all of them.
+	 */
+	class TAUTROPE_API FRopeSegmentTree
+	{
+	public:
+		void Build(TArray<FRopeSegment>&& InSegments);
+		// Refits the node bounds while the segments run between the same rope features as before, otherwise builds.
+		// Refitted trees loosen as segments move, so every TAUT_ROPE_SEGMENT_TREE_MAX_REFITS updates it builds anyway.
+		void Update(TArray<FRopeSegment>&& InSegments);
+		void Query(
+			const FBox& Bounds
+			, TArray<int32>& OutSegmentIndices
+		) const;
+
+		const FRopeSegment& GetSegment(const int32 SegmentIndex) const { return Segments[SegmentIndex]; }
+		int32 Num() const { return Segments.Num(); }
+
+	private:
+		struct FNode
+		{
+			FBox Bounds = FBox(ForceInit);
+			// Leaves cover SegmentOrder[FirstIndex, FirstIndex + Count). Inner nodes have no count and their two
+			// children at FirstIndex and FirstIndex + 1.
+			int32 FirstIndex = 0;
+			int32 Count = 0;
+		};
+
+		void BuildNode(
+			const int32 NodeIndex
+			, const int32 First
+			, const int32 Count
+		);
+		void BuildSegmentBounds();
+
+		TArray<FRopeSegment> Segments;
+		// Parallel to Segments, grown by the segment radius.
+		TArray<FBox> SegmentBounds;
+		TArray<int32> SegmentOrder;
+		TArray<FNode> Nodes;
+		int32 NumRefits = 0;
+	};
+}
\ No newline at end of file
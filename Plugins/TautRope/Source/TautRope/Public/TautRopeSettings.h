@@ -0,0 +1,77 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "TautRopeSettings.generated.h"
+
+UENUM(BlueprintType)
+enum class ETautRopeUpdateLOD : uint8
+{
+	// Updated every frame.
+	Full,
+	// Updated every ReducedRateFrameInterval frames.
+	Reduced,
+	// Updated at FarUpdateRate.
+	Far,
+};
+
+USTRUCT(BlueprintType)
+struct TAUTROPE_API FTautRopeLODSettings
+{
+	GENERATED_BODY()
+
+	// Ropes closer than this to a camera update every frame.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD", meta = (ClampMin = "0", Units = "cm"))
+	float FullRateDistance = 2000.f;
+
+	// Ropes closer than this to a camera update every ReducedRateFrameInterval frames, further ones at FarUpdateRate.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD", meta = (ClampMin = "0", Units = "cm"))
+	float ReducedRateDistance = 6000.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD", meta = (ClampMin = "1"))
+	int32 ReducedRateFrameInterval = 3;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD", meta = (ClampMin = "0.1", Units = "Hz"))
+	float FarUpdateRate = 5.f;
+
+	// Ropes outside every camera's view update at FarUpdateRate regardless of distance.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD")
+	bool bOffScreenIsFar = true;
+
+	// Ropes in view whose mesh the renderer has occlusion culled for OccludedDelay count as off screen.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD", meta = (EditCondition = "bOffScreenIsFar"))
+	bool bOccludedIsOffScreen = true;
+
+	// Keeps ropes that are only briefly hidden, e.g. behind a passing object, at their distance based rate.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD", meta = (EditCondition = "bOffScreenIsFar && bOccludedIsOffScreen", ClampMin = "0", Units = "s"))
+	float OccludedDelay = 0.25f;
+};
+
+UCLASS(config = Game, defaultconfig, meta = (DisplayName = "Taut Rope"))
+class TAUTROPE_API UTautRopeSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UTautRopeSettings();
+
+	// Lets distant and off-screen ropes update at a reduced rate.
+	UPROPERTY(config, EditAnywhere, Category = "LOD")
+	bool bEnableUpdateLOD = true;
+
+	// Used by ropes that do not override their LOD settings.
+	UPROPERTY(config, EditAnywhere, Category = "LOD", meta = (EditCondition = "bEnableUpdateLOD"))
+	FTautRopeLODSettings DefaultLODSettings;
+
+	// Time all rope updates together may take per frame. At least one due rope is updated every frame. 0 disables the budget.
+	UPROPERTY(config, EditAnywhere, Category = "Scheduler", meta = (ClampMin = "0", Units = "ms"))
+	float FrameBudgetMs = 2.f;
+
+	// Due ropes deferred for this many frames are updated before any other rope.
+	UPROPERTY(config, EditAnywhere, Category = "Scheduler", meta = (ClampMin = "1"))
+	int32 MaxDeferredFrames = 8;
+
+	// Ropes whose endpoints moved within this time are treated as recently disturbed.
+	UPROPERTY(config, EditAnywhere, Category = "Scheduler", meta = (ClampMin = "0", Units = "s"))
+	float DisturbedDuration = 1.f;
+};
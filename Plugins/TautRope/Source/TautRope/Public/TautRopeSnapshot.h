@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TautRopeCollisionShape.h"
+#include "TautRopePackedPoint.h"
+
+#include "TautRopeSnapshot.generated.h"
+
+struct FTautRope;
+
+/**
+ * A converged rope saved with the actor or a save game, so the rope resumes wrapped around its shapes
+ * instead of starting again from a straight line.
+ */
+USTRUCT()
+struct TAUTROPE_API FTautRopeSnapshot
+{
+	GENERATED_BODY()
+
+public:
+	bool IsSet() const { return ShapesSignature != 0; }
+	void Reset() { *this = FTautRopeSnapshot(); }
+
+	// Returns false while a collision solve is in progress, which leaves the previous snapshot in place.
+	bool Capture(const FTautRope& Rope);
+
+	// Only restores if the rope's shapes still match the captured ones and every point still fits them.
+	bool Restore(
+		FTautRope& Rope
+		, const float MaxLength
+	) const;
+
+	bool Serialize(FArchive& Ar);
+
+private:
+	// Changes when shapes are added, removed, reshaped or moved while baked. Transforms of shapes following a component
+	// are left out, they carry their points. Independent of the order the shapes were gathered in.
+	static uint32 CalcShapesSignature(const TArray<uint32>& ShapeSignatures);
+	// FTautRopeCollisionShape::CalcSignature of every shape, 0 for shapes standing in for other ropes.
+	static TArray<uint32> CalcShapeSignatures(const TArray<FTautRopeCollisionShape>& Shapes);
+
+	uint32 ShapesSignature = 0;
+	TautRope::FPackedRopeState State;
+	// Signature of the shape of each packed point, to find it again if the shapes are gathered in another order.
+	TArray<uint32> PointShapeSignatures;
+};
+
+template<>
+struct TStructOpsTypeTraits<FTautRopeSnapshot> : public TStructOpsTypeTraitsBase2<FTautRopeSnapshot>
+{
+	enum
+	{
+		WithSerializer = true,
+	};
+};
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TautRopeSegmentTree.h"
+#include "TautRopeSubsystem.generated.h"
+
+class ATautRopeActor;
+
+USTRUCT(BlueprintType)
+struct TAUTROPE_API FTautRopeSchedulerStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Taut Rope")
+	float BudgetMs = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Taut Rope")
+	float SpentMs = 0.f;
+
+	// Ropes due for an update this frame.
+	UPROPERTY(BlueprintReadOnly, Category = "Taut Rope")
+	int32 QueueDepth = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Taut Rope")
+	int32 NumUpdated = 0;
+
+	// Due ropes pushed to a later frame by the budget.
+	UPROPERTY(BlueprintReadOnly, Category = "Taut Rope")
+	int32 NumDeferred = 0;
+};
+
+/**
+ * Owns all rope updates of a world and spends at most the project's frame budget on them.
+ * Due ropes are updated in order of importance; ropes deferred for too long go first.
+ */
+UCLASS()
+class TAUTROPE_API UTautRopeSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	void RegisterRope(ATautRopeActor* Rope);
+	void UnregisterRope(ATautRopeActor* Rope);
+
+	UFUNCTION(BlueprintPure, Category = "Taut Rope")
+	FTautRopeSchedulerStats GetSchedulerStats() const { return Stats; }
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FScheduledRope
+	{
+		TWeakObjectPtr<ATautRopeActor> Rope;
+		// Registration order, which decides which of two colliding ropes wraps over the other.
+		int32 RopeId = INDEX_NONE;
+		int32 FramesDeferred = 0;
+		// Running average of the rope's update time, used to avoid starting updates that would overrun the budget.
+		float EstimatedMs = 0.f;
+	};
+
+	TArray<FScheduledRope> ScheduledRopes;
+	int32 NextRopeId = 0;
+	// Segments of every rope that collides with ropes, refitted or rebuilt at the start of each tick.
+	TautRope::FRopeSegmentTree RopeSegmentTree;
+	FTautRopeSchedulerStats Stats;
+	// Set while ropes update, when unregistered ropes are cleared rather than removed.
+	bool bIsTicking = false;
+};
@@ -21,7 +21,12 @@ public class TautRope : ModuleRules
 			new string[]
 			{
 				"CoreUObject",
-				"Engine"
+				"DeveloperSettings",
+				"Engine",
+				"NetCore",
+				"PhysicsCore",
+				"RenderCore",
+				"RHI"
 			}
 			);
 	}